@@ -0,0 +1,117 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Audio/Music.hpp>
+
+
+namespace
+{
+    // Number of seconds of audio decoded by each iteration
+    const std::size_t decodedSeconds = 4;
+
+    // Format of the generated wav file
+    const unsigned int sampleRate   = 44100;
+    const unsigned int channelCount = 2;
+
+    // Music which gives access to its decoded chunks, without playing them
+    class Decoder : public sf::Music
+    {
+    public :
+
+        bool decode(std::size_t chunkCount)
+        {
+            onSeek(sf::Time::Zero);
+
+            Chunk chunk;
+            for (std::size_t i = 0; i < chunkCount; ++i)
+            {
+                onGetData(chunk);
+                if (chunk.sampleCount == 0)
+                    return false;
+                keep(static_cast<sf::Uint64>(chunk.samples[chunk.sampleCount - 1]));
+            }
+            return true;
+        }
+    };
+
+    // Append a little-endian integer to a buffer
+    void writeInteger(std::vector<char>& buffer, sf::Uint32 value, unsigned int size)
+    {
+        for (unsigned int i = 0; i < size; ++i)
+            buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    // Generate a 16 bits PCM wav file in memory
+    const std::vector<char>& getWav()
+    {
+        static std::vector<char> wav;
+        if (!wav.empty())
+            return wav;
+
+        const sf::Uint32 sampleCount = sampleRate * channelCount * decodedSeconds;
+        const char riff[] = "RIFF";
+        const char format[] = "WAVEfmt ";
+        const char data[] = "data";
+        wav.insert(wav.end(), riff, riff + 4);
+        writeInteger(wav, 36 + sampleCount * 2, 4);
+        wav.insert(wav.end(), format, format + 8);
+        writeInteger(wav, 16, 4);
+        writeInteger(wav, 1, 2);
+        writeInteger(wav, channelCount, 2);
+        writeInteger(wav, sampleRate, 4);
+        writeInteger(wav, sampleRate * channelCount * 2, 4);
+        writeInteger(wav, channelCount * 2, 2);
+        writeInteger(wav, 16, 2);
+        wav.insert(wav.end(), data, data + 4);
+        writeInteger(wav, sampleCount * 2, 4);
+        for (sf::Uint32 i = 0; i < sampleCount; ++i)
+            writeInteger(wav, static_cast<sf::Uint16>((i * 97) % 65536), 2);
+
+        return wav;
+    }
+
+    bool decodeWav(std::size_t count)
+    {
+        static Decoder decoder;
+        static bool opened = decoder.openFromMemory(&getWav()[0], getWav().size());
+        if (!opened)
+            return false;
+
+        // Music reads chunks of one second
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!decoder.decode(decodedSeconds))
+                return false;
+        }
+        return true;
+    }
+
+    bool decodeOgg(std::size_t count)
+    {
+        static Decoder decoder;
+        static bool opened = decoder.openFromFile(resourcesPath + "/sound/resources/orchestral.ogg");
+        if (!opened)
+            return false;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!decoder.decode(decodedSeconds))
+                return false;
+        }
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void addAudioBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+    Benchmark list[] =
+    {
+        {"audio/decode_wav", "seconds of audio", decodedSeconds, false, &decodeWav},
+        {"audio/decode_ogg", "seconds of audio", decodedSeconds, false, &decodeOgg}
+    };
+    benchmarks.insert(benchmarks.end(), list, list + sizeof(list) / sizeof(*list));
+}
@@ -0,0 +1,48 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+// Description of a benchmark
+////////////////////////////////////////////////////////////
+struct Benchmark
+{
+    std::string name;                    // unique name, prefixed with the module name
+    std::string unit;                    // unit of the items processed by the benchmark
+    double      items;                   // number of items processed by each iteration
+    bool        needsContext;            // does the benchmark need an OpenGL context?
+    bool      (*run)(std::size_t count); // run the given number of iterations, return false if unavailable
+};
+
+
+////////////////////////////////////////////////////////////
+// Directory of the resources used by some benchmarks
+// (the resources of the SFML examples)
+////////////////////////////////////////////////////////////
+extern std::string resourcesPath;
+
+
+////////////////////////////////////////////////////////////
+// Keep a value alive, so that the compiler cannot optimize
+// away the computations of a benchmark
+////////////////////////////////////////////////////////////
+void keep(sf::Uint64 value);
+
+
+////////////////////////////////////////////////////////////
+// Add the benchmarks of each module to a list
+////////////////////////////////////////////////////////////
+void addSystemBenchmarks(std::vector<Benchmark>& benchmarks);
+void addGraphicsBenchmarks(std::vector<Benchmark>& benchmarks);
+void addAudioBenchmarks(std::vector<Benchmark>& benchmarks);
+void addNetworkBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,599 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/GifDecoder.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RecordingRenderTarget.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Size of the images
+    const unsigned int imageSize = 1024;
+    const unsigned int copySize  = 512;
+
+    // Number of transforms and points processed by each iteration
+    const std::size_t transformCount = 1024;
+    const std::size_t pointCount     = 4096;
+
+    // Number of points of the benchmarked shape
+    const std::size_t shapePointCount = 256;
+
+    // Number of characters of the benchmarked text
+    const std::size_t textLength = 1024;
+
+    // Number of glyphs looked up by each iteration of the glyph cache benchmark
+    const std::size_t glyphCount = 4096;
+
+    // Number of entities drawn by each iteration of the submission benchmarks
+    const std::size_t entityCount = 1024;
+
+    // Size and number of frames of the generated gif animation
+    const unsigned int gifSize       = 256;
+    const unsigned int gifFrameCount = 16;
+
+    // Image filled with a gradient of colors and alpha
+    sf::Image makeImage(unsigned int size, sf::Uint8 seed)
+    {
+        std::vector<sf::Uint8> pixels(size * size * 4);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<sf::Uint8>(i * 7 + seed + i / (size * 4));
+
+        sf::Image image;
+        image.create(size, size, &pixels[0]);
+        return image;
+    }
+
+    bool imageCopy(std::size_t count, bool applyAlpha)
+    {
+        static const sf::Image source = makeImage(copySize, 1);
+        static sf::Image destination = makeImage(imageSize, 2);
+        for (std::size_t i = 0; i < count; ++i)
+            destination.copy(source, i % 64, i % 32, sf::IntRect(0, 0, 0, 0), applyAlpha);
+        keep(destination.getPixelsPtr()[0]);
+        return true;
+    }
+
+    bool imageCopyOpaque(std::size_t count)
+    {
+        return imageCopy(count, false);
+    }
+
+    bool imageCopyAlpha(std::size_t count)
+    {
+        return imageCopy(count, true);
+    }
+
+    bool imageFlipHorizontally(std::size_t count)
+    {
+        static sf::Image image = makeImage(imageSize, 3);
+        for (std::size_t i = 0; i < count; ++i)
+            image.flipHorizontally();
+        keep(image.getPixelsPtr()[0]);
+        return true;
+    }
+
+    bool imageFlipVertically(std::size_t count)
+    {
+        static sf::Image image = makeImage(imageSize, 4);
+        for (std::size_t i = 0; i < count; ++i)
+            image.flipVertically();
+        keep(image.getPixelsPtr()[0]);
+        return true;
+    }
+
+    bool imageCreate(std::size_t count)
+    {
+        static sf::Image image;
+        for (std::size_t i = 0; i < count; ++i)
+            image.create(imageSize, imageSize, sf::Color(static_cast<sf::Uint8>(i), 20, 30, 40));
+        keep(image.getPixelsPtr()[0]);
+        return true;
+    }
+
+    bool imageMask(std::size_t count)
+    {
+        // The gradient repeats, so that some pixels match the masked color
+        static sf::Image image = makeImage(imageSize, 5);
+        for (std::size_t i = 0; i < count; ++i)
+            image.createMaskFromColor(image.getPixel(i % imageSize, 0), static_cast<sf::Uint8>(i));
+        keep(image.getPixelsPtr()[3]);
+        return true;
+    }
+
+    bool imageSetAlpha(std::size_t count)
+    {
+        static sf::Image image = makeImage(imageSize, 6);
+        for (std::size_t i = 0; i < count; ++i)
+            image.setAlpha(i % 256);
+        keep(image.getPixelsPtr()[3]);
+        return true;
+    }
+
+    // Transforms mixing translations, rotations and scales
+    const std::vector<sf::Transform>& getTransforms()
+    {
+        static std::vector<sf::Transform> transforms;
+        if (transforms.empty())
+        {
+            for (std::size_t i = 0; i < transformCount; ++i)
+            {
+                sf::Transform transform;
+                transform.translate(static_cast<float>(i % 100), static_cast<float>(i % 37));
+                transform.rotate(static_cast<float>(i % 360));
+                transform.scale(1.f + (i % 5) * 0.001f, 1.f - (i % 7) * 0.001f);
+                transforms.push_back(transform);
+            }
+        }
+        return transforms;
+    }
+
+    bool transformCombine(std::size_t count)
+    {
+        const std::vector<sf::Transform>& transforms = getTransforms();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Transform result;
+            for (std::size_t j = 0; j < transformCount; ++j)
+                result.combine(transforms[j]);
+            keep(static_cast<sf::Uint64>(result.transformPoint(0.f, 0.f).x));
+        }
+        return true;
+    }
+
+    bool transformPoint(std::size_t count)
+    {
+        const sf::Transform& transform = getTransforms()[123];
+        std::vector<sf::Vector2f> points(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+            points[i] = sf::Vector2f(static_cast<float>(i % 640), static_cast<float>(i / 640));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float sum = 0;
+            for (std::size_t j = 0; j < pointCount; ++j)
+                sum += transform.transformPoint(points[j]).x;
+            keep(static_cast<sf::Uint64>(sum));
+        }
+        return true;
+    }
+
+    bool transformPoints(std::size_t count)
+    {
+        const sf::Transform& transform = getTransforms()[123];
+        std::vector<sf::Vertex> vertices(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+            vertices[i].position = sf::Vector2f(static_cast<float>(i % 640), static_cast<float>(i / 640));
+
+        std::vector<sf::Vertex> result(pointCount);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            transform.transformPoints(&vertices[0], &result[0], pointCount);
+            keep(static_cast<sf::Uint64>(result[i % pointCount].position.x));
+        }
+        return true;
+    }
+
+    bool shapeUpdate(std::size_t count)
+    {
+        // Changing the radius recomputes all the vertices, the outline and the bounds
+        sf::CircleShape shape(100.f, shapePointCount);
+        shape.setOutlineThickness(2.f);
+        for (std::size_t i = 0; i < count; ++i)
+            shape.setRadius(100.f + (i % 2));
+        keep(static_cast<sf::Uint64>(shape.getLocalBounds().width));
+        return true;
+    }
+
+    // Load the font used by the text benchmarks
+    const sf::Font* getFont()
+    {
+        static sf::Font font;
+        static bool loaded = font.loadFromFile(resourcesPath + "/pong/resources/sansation.ttf");
+        return loaded ? &font : NULL;
+    }
+
+    bool textGeometry(std::size_t count)
+    {
+        const sf::Font* font = getFont();
+        if (!font)
+            return false;
+
+        // Two strings with the same characters, so that only the first iteration loads glyphs
+        static std::string strings[2];
+        if (strings[0].empty())
+        {
+            for (std::size_t i = 0; i < textLength; ++i)
+            {
+                char c = (i % 40 == 39) ? '\n' : static_cast<char>('A' + i % 58);
+                strings[0].push_back(c);
+                strings[1].insert(strings[1].begin(), c == '\n' ? ' ' : c);
+            }
+        }
+
+        // The geometry is computed lazily, measuring the text forces the update
+        sf::Text text("", *font, 20);
+        float width = 0.f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            text.setString(strings[i % 2]);
+            width += text.getLocalBounds().width;
+        }
+        keep(static_cast<sf::Uint64>(width));
+        return true;
+    }
+
+    bool textAppend(std::size_t count)
+    {
+        const sf::Font* font = getFont();
+        if (!font)
+            return false;
+
+        // Console log: one character is typed at the end of a long text per iteration
+        static sf::String log;
+        static sf::Text text;
+        if (log.isEmpty())
+        {
+            for (std::size_t i = 0; i < textLength * 16; ++i)
+                log += sf::String(static_cast<sf::Uint32>((i % 40 == 39) ? '\n' : 'a' + i % 26));
+            text = sf::Text(log, *font, 20);
+        }
+
+        float height = 0.f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::String string = log;
+            string += sf::String(static_cast<sf::Uint32>('a' + i % 26));
+            text.setString(string);
+            height += text.getLocalBounds().height;
+        }
+        keep(static_cast<sf::Uint64>(height));
+        return true;
+    }
+
+    bool textCaret(std::size_t count)
+    {
+        const sf::Font* font = getFont();
+        if (!font)
+            return false;
+
+        // Editor: the cursor is placed where the mouse is, and drawn at the position of its character
+        static sf::Text text;
+        if (text.getString().isEmpty())
+        {
+            std::string string;
+            for (std::size_t i = 0; i < textLength * 16; ++i)
+                string.push_back((i % 40 == 39) ? '\n' : static_cast<char>('a' + i % 26));
+            text = sf::Text(string, *font, 20);
+        }
+
+        float sum = 0.f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Vector2f mouse(static_cast<float>(i * 37 % 400), static_cast<float>(i * 101 % 12000));
+            sum += text.findCharacterPos(text.findCharacterIndex(mouse)).x;
+        }
+        keep(static_cast<sf::Uint64>(sum));
+        return true;
+    }
+
+    bool glyphLookup(std::size_t count)
+    {
+        const sf::Font* font = getFont();
+        if (!font)
+            return false;
+
+        // Chat-like log: mostly ASCII, some accented latin and cyrillic characters, a few sizes
+        static std::vector<sf::Uint32> codePoints;
+        if (codePoints.empty())
+        {
+            for (std::size_t i = 0; i < glyphCount; ++i)
+            {
+                if (i % 29 == 0)
+                    codePoints.push_back(0x410 + i % 32);
+                else if (i % 13 == 0)
+                    codePoints.push_back(0xE0 + i % 24);
+                else
+                    codePoints.push_back(' ' + i % 95);
+            }
+        }
+
+        sf::Uint64 sum = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            unsigned int characterSize = 12 + (i % 3) * 4;
+            for (std::size_t j = 0; j < codePoints.size(); ++j)
+                sum += static_cast<sf::Uint64>(font->getGlyph(codePoints[j], characterSize, false).advance);
+        }
+        keep(sum);
+        return true;
+    }
+
+    bool kerningLookup(std::size_t count)
+    {
+        const sf::Font* font = getFont();
+        if (!font)
+            return false;
+
+        // Same mix of characters as the glyph cache benchmark, looked up by adjacent pairs
+        static std::vector<sf::Uint32> codePoints;
+        if (codePoints.empty())
+        {
+            for (std::size_t i = 0; i <= glyphCount; ++i)
+            {
+                if (i % 29 == 0)
+                    codePoints.push_back(0x410 + i % 32);
+                else if (i % 13 == 0)
+                    codePoints.push_back(0xE0 + i % 24);
+                else
+                    codePoints.push_back(' ' + i % 95);
+            }
+            font->getGlyph('A', 20, false);
+        }
+
+        sf::Int64 sum = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = 0; j < glyphCount; ++j)
+                sum += font->getKerning(codePoints[j], codePoints[j + 1], 20);
+        }
+        keep(static_cast<sf::Uint64>(sum));
+        return true;
+    }
+
+    // Load the Latin-1 and kana glyphs into a new font, one by one or all at once
+    bool fontWarmup(std::size_t count, bool preload)
+    {
+        std::vector<sf::Font::Range> ranges;
+        ranges.push_back(sf::Font::Range(0x20, 0xFF));
+        ranges.push_back(sf::Font::Range(0x3040, 0x30FF));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Font font;
+            if (!font.loadFromFile(resourcesPath + "/pong/resources/sansation.ttf"))
+                return false;
+
+            if (preload)
+            {
+                font.preload(ranges, 24, false);
+            }
+            else
+            {
+                for (std::size_t j = 0; j < ranges.size(); ++j)
+                    for (sf::Uint32 codePoint = ranges[j].first; codePoint <= ranges[j].last; ++codePoint)
+                        font.getGlyph(codePoint, 24, false);
+            }
+            keep(font.getTexture(24).getSize().x);
+        }
+        return true;
+    }
+
+    bool fontWarmupSerial(std::size_t count)
+    {
+        return fontWarmup(count, false);
+    }
+
+    bool fontWarmupPreload(std::size_t count)
+    {
+        return fontWarmup(count, true);
+    }
+
+    // Draw entities to a target which only records the commands, and check the number of draw calls
+    template <typename T>
+    bool submit(std::size_t count, const std::vector<T>& entities, bool batching, unsigned int expectedDrawCalls)
+    {
+        static sf::RecordingRenderTarget target(800, 600);
+        target.setBatchingEnabled(batching);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            target.clearRecording();
+            for (std::size_t j = 0; j < entities.size(); ++j)
+                target.draw(entities[j]);
+            target.flush();
+
+            if (expectedDrawCalls && (target.getCounters().drawCalls != expectedDrawCalls))
+                return false;
+        }
+        keep(target.getCounters().vertexCount);
+        return true;
+    }
+
+    const std::vector<sf::RectangleShape>& getRectangles()
+    {
+        static std::vector<sf::RectangleShape> rectangles;
+        if (rectangles.empty())
+        {
+            for (std::size_t i = 0; i < entityCount; ++i)
+            {
+                sf::RectangleShape rectangle(sf::Vector2f(16.f, 16.f));
+                rectangle.setPosition(static_cast<float>(i % 50 * 16), static_cast<float>(i / 50 * 16));
+                rectangle.setFillColor(sf::Color(i % 256, 128, 255 - i % 256));
+                rectangles.push_back(rectangle);
+            }
+        }
+        return rectangles;
+    }
+
+    bool submitShapes(std::size_t count)
+    {
+        return submit(count, getRectangles(), false, entityCount);
+    }
+
+    bool submitShapesBatched(std::size_t count)
+    {
+        return submit(count, getRectangles(), true, 1);
+    }
+
+    const std::vector<sf::Sprite>& getSprites()
+    {
+        // Sprites are only drawn when they have a texture, and creating one requires a context
+        static sf::Texture texture;
+        static std::vector<sf::Sprite> sprites;
+        if (sprites.empty() && texture.create(64, 64))
+        {
+            for (std::size_t i = 0; i < entityCount; ++i)
+            {
+                sf::Sprite sprite(texture, sf::IntRect(i % 4 * 16, i / 4 % 4 * 16, 16, 16));
+                sprite.setPosition(static_cast<float>(i % 50 * 16), static_cast<float>(i / 50 * 16));
+                sprite.setRotation(static_cast<float>(i % 360));
+                sprites.push_back(sprite);
+            }
+        }
+        return sprites;
+    }
+
+    bool submitSprites(std::size_t count)
+    {
+        return !getSprites().empty() && submit(count, getSprites(), false, entityCount);
+    }
+
+    bool submitSpritesBatched(std::size_t count)
+    {
+        return !getSprites().empty() && submit(count, getSprites(), true, 1);
+    }
+
+    bool submitText(std::size_t count)
+    {
+        const sf::Font* font = getFont();
+        if (!font)
+            return false;
+
+        static std::vector<sf::Text> texts;
+        if (texts.empty())
+        {
+            std::string string;
+            for (std::size_t i = 0; i < textLength; ++i)
+                string.push_back((i % 40 == 39) ? '\n' : static_cast<char>('A' + i % 58));
+            texts.push_back(sf::Text(string, *font, 20));
+        }
+        return submit(count, texts, false, 1);
+    }
+
+    // Append the bits of a LZW code to a gif data stream
+    void writeCode(std::vector<sf::Uint8>& data, sf::Uint32& buffer, unsigned int& bits, sf::Uint32 code)
+    {
+        buffer |= code << bits;
+        for (bits += 9; bits >= 8; bits -= 8, buffer >>= 8)
+            data.push_back(static_cast<sf::Uint8>(buffer & 0xFF));
+    }
+
+    // Generate an animated gif in memory; the LZW stream is not compressed
+    // (a clear code is emitted often enough to keep 9-bits codes), which is
+    // easy to produce while exercising the whole decoding path
+    const std::vector<sf::Uint8>& getGif()
+    {
+        static std::vector<sf::Uint8> gif;
+        if (!gif.empty())
+            return gif;
+
+        const char header[] = "GIF89a";
+        gif.insert(gif.end(), header, header + 6);
+        const sf::Uint8 screen[] = {gifSize & 0xFF, gifSize >> 8, gifSize & 0xFF, gifSize >> 8, 0xF7, 0, 0};
+        gif.insert(gif.end(), screen, screen + sizeof(screen));
+        for (unsigned int i = 0; i < 256; ++i)
+        {
+            gif.push_back(static_cast<sf::Uint8>(i));
+            gif.push_back(static_cast<sf::Uint8>(255 - i));
+            gif.push_back(static_cast<sf::Uint8>(i * 3));
+        }
+
+        for (unsigned int frame = 0; frame < gifFrameCount; ++frame)
+        {
+            // Graphics control block (do not dispose, 40 ms, transparent index 0) and image descriptor
+            const sf::Uint8 control[] = {0x21, 0xF9, 4, 0x05, 4, 0, 0, 0};
+            gif.insert(gif.end(), control, control + sizeof(control));
+            const sf::Uint8 descriptor[] = {0x2C, 0, 0, 0, 0, gifSize & 0xFF, gifSize >> 8, gifSize & 0xFF, gifSize >> 8, 0};
+            gif.insert(gif.end(), descriptor, descriptor + sizeof(descriptor));
+
+            // LZW data, with a minimum code size of 8 bits
+            std::vector<sf::Uint8> data;
+            sf::Uint32 buffer = 0;
+            unsigned int bits = 0;
+            for (unsigned int i = 0; i < gifSize * gifSize; ++i)
+            {
+                if (i % 128 == 0)
+                    writeCode(data, buffer, bits, 256);
+                writeCode(data, buffer, bits, (i + i / gifSize * 3 + frame * 5) % 256);
+            }
+            writeCode(data, buffer, bits, 257);
+            if (bits > 0)
+                data.push_back(static_cast<sf::Uint8>(buffer & 0xFF));
+
+            // Split the data in sub-blocks
+            gif.push_back(8);
+            for (std::size_t offset = 0; offset < data.size(); offset += 255)
+            {
+                std::size_t size = std::min<std::size_t>(255, data.size() - offset);
+                gif.push_back(static_cast<sf::Uint8>(size));
+                gif.insert(gif.end(), data.begin() + offset, data.begin() + offset + size);
+            }
+            gif.push_back(0);
+        }
+
+        gif.push_back(0x3B);
+        return gif;
+    }
+
+    bool gifDecode(std::size_t count)
+    {
+        const std::vector<sf::Uint8>& gif = getGif();
+        sf::GifDecoder decoder;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!decoder.openFromMemory(&gif[0], gif.size()))
+                return false;
+            while (decoder.readNextFrame())
+            {
+            }
+            if (decoder.getFrameCount() != gifFrameCount)
+                return false;
+            keep(decoder.getPixelsPtr()[0]);
+        }
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void addGraphicsBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+    Benchmark list[] =
+    {
+        {"graphics/image_copy",              "pixels",     copySize * copySize,   false, &imageCopyOpaque},
+        {"graphics/image_copy_alpha",        "pixels",     copySize * copySize,   false, &imageCopyAlpha},
+        {"graphics/image_flip_horizontally", "pixels",     imageSize * imageSize, false, &imageFlipHorizontally},
+        {"graphics/image_flip_vertically",   "pixels",     imageSize * imageSize, false, &imageFlipVertically},
+        {"graphics/image_create",            "pixels",     imageSize * imageSize, false, &imageCreate},
+        {"graphics/image_mask",              "pixels",     imageSize * imageSize, false, &imageMask},
+        {"graphics/image_set_alpha",         "pixels",     imageSize * imageSize, false, &imageSetAlpha},
+        {"graphics/transform_combine",       "transforms", transformCount,        false, &transformCombine},
+        {"graphics/transform_point",         "points",     pointCount,            false, &transformPoint},
+        {"graphics/transform_points",        "points",     pointCount,            false, &transformPoints},
+        {"graphics/shape_update",            "points",     shapePointCount,       false, &shapeUpdate},
+        {"graphics/text_geometry",           "characters", textLength,            true,  &textGeometry},
+        {"graphics/text_append",             "characters", 1,                     true,  &textAppend},
+        {"graphics/text_caret",              "queries",    1,                     true,  &textCaret},
+        {"graphics/glyph_lookup",            "glyphs",     glyphCount,            true,  &glyphLookup},
+        {"graphics/kerning_lookup",          "pairs",      glyphCount,            true,  &kerningLookup},
+        {"graphics/font_warmup",             "fonts",      1,                     true,  &fontWarmupSerial},
+        {"graphics/font_warmup_preload",     "fonts",      1,                     true,  &fontWarmupPreload},
+        {"graphics/submit_shapes",           "shapes",     entityCount,           false, &submitShapes},
+        {"graphics/submit_shapes_batched",   "shapes",     entityCount,           false, &submitShapesBatched},
+        {"graphics/submit_sprites",          "sprites",    entityCount,           true,  &submitSprites},
+        {"graphics/submit_sprites_batched",  "sprites",    entityCount,           true,  &submitSpritesBatched},
+        {"graphics/submit_text",             "characters", textLength,            true,  &submitText},
+        {"graphics/gif_decode",              "frames",     gifFrameCount,         false, &gifDecode}
+    };
+    benchmarks.insert(benchmarks.end(), list, list + sizeof(list) / sizeof(*list));
+}
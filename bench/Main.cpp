@@ -0,0 +1,240 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+
+////////////////////////////////////////////////////////////
+// Global variables shared with the benchmarks
+////////////////////////////////////////////////////////////
+#ifdef SFML_BENCH_RESOURCES
+std::string resourcesPath = SFML_BENCH_RESOURCES;
+#else
+std::string resourcesPath = "resources";
+#endif
+
+namespace
+{
+    volatile sf::Uint64 sink = 0;
+}
+
+void keep(sf::Uint64 value)
+{
+    sink += value;
+}
+
+
+namespace
+{
+    // Result of a benchmark
+    struct Result
+    {
+        const Benchmark* benchmark;
+        std::size_t      iterations;
+        double           seconds;
+    };
+
+    // Time a number of iterations of a benchmark, in seconds
+    double measure(const Benchmark& benchmark, std::size_t count)
+    {
+        sf::Clock clock;
+        benchmark.run(count);
+        return clock.getElapsedTime().asMicroseconds() / 1000000.0;
+    }
+
+    // Run a benchmark: find the number of iterations that lasts at least
+    // the minimum time, then keep the median of a few runs of this size
+    Result run(const Benchmark& benchmark, double minTime, int repetitions)
+    {
+        Result result = {&benchmark, 1, 0.0};
+
+        double seconds = measure(benchmark, result.iterations);
+        while (seconds < minTime)
+        {
+            double factor = seconds > 0 ? minTime * 1.2 / seconds : 10.0;
+            result.iterations = static_cast<std::size_t>(result.iterations * std::min(std::max(factor, 2.0), 10.0));
+            seconds = measure(benchmark, result.iterations);
+        }
+
+        std::vector<double> times(1, seconds);
+        for (int i = 1; i < repetitions; ++i)
+            times.push_back(measure(benchmark, result.iterations));
+        std::sort(times.begin(), times.end());
+        result.seconds = times[times.size() / 2];
+
+        return result;
+    }
+
+    // Write a string as a JSON string literal (names contain no special characters)
+    std::string quote(const std::string& string)
+    {
+        return "\"" + string + "\"";
+    }
+
+    // Write the results as JSON
+    void writeJson(std::ostream& stream, const std::vector<Result>& results, const std::vector<std::string>& skipped)
+    {
+        stream << std::setprecision(6);
+        stream << "{\n";
+        stream << "  \"sfml_version\": \"" << SFML_VERSION_MAJOR << "." << SFML_VERSION_MINOR << "\",\n";
+        stream << "  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+            double perIteration = result.seconds / result.iterations;
+            stream << (i ? ",\n" : "\n");
+            stream << "    {\"name\": " << quote(result.benchmark->name)
+                   << ", \"unit\": " << quote(result.benchmark->unit)
+                   << ", \"iterations\": " << result.iterations
+                   << ", \"seconds\": " << result.seconds
+                   << ", \"ns_per_iteration\": " << perIteration * 1000000000.0
+                   << ", \"items_per_second\": " << result.benchmark->items / perIteration << "}";
+        }
+        stream << "\n  ],\n";
+        stream << "  \"skipped\": [";
+        for (std::size_t i = 0; i < skipped.size(); ++i)
+            stream << (i ? ", " : "") << quote(skipped[i]);
+        stream << "]\n";
+        stream << "}\n";
+    }
+
+    // Print the usage of the program
+    void printUsage()
+    {
+        std::cout << "usage: sfml-bench [options]\n"
+                  << "  --list              list the benchmarks and exit\n"
+                  << "  --filter <text>     only run the benchmarks whose name contains <text>\n"
+                  << "  --min-time <sec>    minimum duration of a measure (default: 0.2)\n"
+                  << "  --repetitions <n>   number of measures, the median is kept (default: 3)\n"
+                  << "  --json <file>       write the results to <file> as JSON (- for the standard output)\n"
+                  << "  --resources <dir>   directory of the example resources\n"
+                  << "  --with-context      also run the benchmarks which need an OpenGL context\n"
+                  << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Parse the command line
+    bool list = false;
+    bool withContext = false;
+    std::string filter;
+    std::string jsonFile;
+    double minTime = 0.2;
+    int repetitions = 3;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--list")
+            list = true;
+        else if (arg == "--with-context")
+            withContext = true;
+        else if ((arg == "--filter") && hasValue)
+            filter = argv[++i];
+        else if ((arg == "--min-time") && hasValue)
+            minTime = std::atof(argv[++i]);
+        else if ((arg == "--repetitions") && hasValue)
+            repetitions = std::max(std::atoi(argv[++i]), 1);
+        else if ((arg == "--json") && hasValue)
+            jsonFile = argv[++i];
+        else if ((arg == "--resources") && hasValue)
+            resourcesPath = argv[++i];
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Gather the benchmarks of all the modules
+    std::vector<Benchmark> benchmarks;
+    addSystemBenchmarks(benchmarks);
+    addGraphicsBenchmarks(benchmarks);
+    addAudioBenchmarks(benchmarks);
+    addNetworkBenchmarks(benchmarks);
+
+    if (list)
+    {
+        for (std::size_t i = 0; i < benchmarks.size(); ++i)
+            std::cout << benchmarks[i].name << (benchmarks[i].needsContext ? " (needs an OpenGL context)" : "") << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    // The OpenGL context must remain active while the benchmarks are running
+    sf::Context* context = withContext ? new sf::Context : NULL;
+
+    // When the JSON goes to the standard output, don't mix it with the table
+    bool table = jsonFile != "-";
+    if (table)
+    {
+        std::cout << std::left << std::setw(36) << "benchmark" << std::right << std::setw(16) << "ns/iteration"
+                  << std::setw(20) << "items/s" << "  unit" << std::endl;
+    }
+
+    std::vector<Result> results;
+    std::vector<std::string> skipped;
+    for (std::size_t i = 0; i < benchmarks.size(); ++i)
+    {
+        const Benchmark& benchmark = benchmarks[i];
+        if (benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        // Check that the benchmark can run (context, resources) and warm it up
+        if ((benchmark.needsContext && !withContext) || !benchmark.run(1))
+        {
+            skipped.push_back(benchmark.name);
+            if (table)
+                std::cout << std::left << std::setw(36) << benchmark.name << "skipped" << std::endl;
+            continue;
+        }
+
+        Result result = run(benchmark, minTime, repetitions);
+        results.push_back(result);
+
+        if (table)
+        {
+            double perIteration = result.seconds / result.iterations;
+            std::cout << std::left << std::setw(36) << benchmark.name << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(16) << perIteration * 1000000000.0
+                      << std::setprecision(0) << std::setw(20) << benchmark.items / perIteration
+                      << "  " << benchmark.unit << std::endl;
+        }
+    }
+
+    delete context;
+
+    // Write the machine-readable results
+    if (jsonFile == "-")
+    {
+        writeJson(std::cout, results, skipped);
+    }
+    else if (!jsonFile.empty())
+    {
+        std::ofstream file(jsonFile.c_str());
+        writeJson(file, results, skipped);
+        if (!file)
+        {
+            std::cerr << "Failed to write the results to " << jsonFile << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+
+namespace
+{
+    // Number of records serialized into a packet
+    const std::size_t recordCount = 64;
+
+    // Size of the messages exchanged over the loopback sockets
+    const std::size_t messageSize = 64;
+
+    // Serialize records made of values of each type
+    void fillPacket(sf::Packet& packet)
+    {
+        static const std::string name = "player";
+        for (std::size_t i = 0; i < recordCount; ++i)
+        {
+            packet << static_cast<sf::Uint8>(i) << static_cast<sf::Int16>(i * 3) << static_cast<sf::Uint32>(i * 1000)
+                   << static_cast<float>(i) * 0.5f << static_cast<double>(i) * 0.25 << name;
+        }
+    }
+
+    bool packetWrite(std::size_t count)
+    {
+        sf::Packet packet;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            packet.clear();
+            fillPacket(packet);
+            keep(packet.getDataSize());
+        }
+        return true;
+    }
+
+    bool packetRead(std::size_t count)
+    {
+        sf::Packet source;
+        fillPacket(source);
+
+        sf::Uint8 a;
+        sf::Int16 b;
+        sf::Uint32 c;
+        float d;
+        double e;
+        std::string f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Packet packet = source;
+            for (std::size_t j = 0; j < recordCount; ++j)
+                packet >> a >> b >> c >> d >> e >> f;
+            if (!packet)
+                return false;
+            keep(c);
+        }
+        return true;
+    }
+
+    bool tcpRoundTrip(std::size_t count)
+    {
+        // Connect a pair of sockets through the loopback interface
+        static sf::TcpListener listener;
+        static sf::TcpSocket client;
+        static sf::TcpSocket server;
+        static bool connected = (listener.listen(0) == sf::Socket::Done) &&
+                                (client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done) &&
+                                (listener.accept(server) == sf::Socket::Done);
+        if (!connected)
+            return false;
+
+        sf::Packet packet;
+        packet.append(std::string(messageSize, 'x').c_str(), messageSize);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if ((client.send(packet) != sf::Socket::Done) ||
+                (server.receive(packet) != sf::Socket::Done) ||
+                (server.send(packet) != sf::Socket::Done) ||
+                (client.receive(packet) != sf::Socket::Done))
+                return false;
+        }
+        return true;
+    }
+
+    bool udpRoundTrip(std::size_t count)
+    {
+        static sf::UdpSocket client;
+        static sf::UdpSocket server;
+        static bool bound = (client.bind(sf::Socket::AnyPort) == sf::Socket::Done) &&
+                            (server.bind(sf::Socket::AnyPort) == sf::Socket::Done);
+        if (!bound)
+            return false;
+
+        char message[messageSize] = {0};
+        std::size_t received;
+        sf::IpAddress address;
+        unsigned short port;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if ((client.send(message, messageSize, sf::IpAddress::LocalHost, server.getLocalPort()) != sf::Socket::Done) ||
+                (server.receive(message, messageSize, received, address, port) != sf::Socket::Done) ||
+                (server.send(message, received, address, port) != sf::Socket::Done) ||
+                (client.receive(message, messageSize, received, address, port) != sf::Socket::Done))
+                return false;
+        }
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void addNetworkBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+    Benchmark list[] =
+    {
+        {"network/packet_write",   "records",     recordCount, false, &packetWrite},
+        {"network/packet_read",    "records",     recordCount, false, &packetRead},
+        {"network/tcp_round_trip", "round trips", 1,           false, &tcpRoundTrip},
+        {"network/udp_round_trip", "round trips", 1,           false, &udpRoundTrip}
+    };
+    benchmarks.insert(benchmarks.end(), list, list + sizeof(list) / sizeof(*list));
+}
@@ -0,0 +1,124 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/System/String.hpp>
+#include <SFML/System/Utf.hpp>
+#include <iterator>
+
+
+namespace
+{
+    // Number of characters of the converted texts
+    const std::size_t textLength = 4096;
+
+    // Mixed text with 1, 2, 3 and 4 bytes UTF-8 sequences
+    const std::basic_string<sf::Uint32>& getUtf32Text()
+    {
+        static std::basic_string<sf::Uint32> text;
+        if (text.empty())
+        {
+            const sf::Uint32 sample[] = {'H', 'e', 'l', 'l', 'o', ' ', 0xE9, 0x3B1, 0x3B2, ' ', 0x6F22, 0x5B57, ' ', 0x1F600, '!', '\n'};
+            const std::size_t sampleLength = sizeof(sample) / sizeof(*sample);
+            for (std::size_t i = 0; i < textLength; ++i)
+                text.push_back(sample[i % sampleLength]);
+        }
+        return text;
+    }
+
+    const std::string& getUtf8Text()
+    {
+        static std::string text;
+        if (text.empty())
+        {
+            const std::basic_string<sf::Uint32>& utf32 = getUtf32Text();
+            sf::Utf32::toUtf8(utf32.begin(), utf32.end(), std::back_inserter(text));
+        }
+        return text;
+    }
+
+    const std::string& getAnsiText()
+    {
+        static std::string text;
+        if (text.empty())
+        {
+            for (std::size_t i = 0; i < textLength; ++i)
+                text.push_back(static_cast<char>('a' + i % 26));
+        }
+        return text;
+    }
+
+    bool utf8ToUtf32(std::size_t count)
+    {
+        const std::string& input = getUtf8Text();
+        std::vector<sf::Uint32> output(textLength);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Utf8::toUtf32(input.begin(), input.end(), output.begin());
+            keep(output[i % textLength]);
+        }
+        return true;
+    }
+
+    bool utf32ToUtf8(std::size_t count)
+    {
+        const std::basic_string<sf::Uint32>& input = getUtf32Text();
+        std::vector<sf::Uint8> output(textLength * 4);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::vector<sf::Uint8>::iterator end = sf::Utf32::toUtf8(input.begin(), input.end(), output.begin());
+            keep(end - output.begin());
+        }
+        return true;
+    }
+
+    bool stringFromUtf8(std::size_t count)
+    {
+        const std::string& input = getUtf8Text();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::String string = sf::String::fromUtf8(input.begin(), input.end());
+            keep(string.getSize());
+        }
+        return true;
+    }
+
+    bool stringFromAnsi(std::size_t count)
+    {
+        const std::string& input = getAnsiText();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::String string(input);
+            keep(string.getSize());
+        }
+        return true;
+    }
+
+    bool stringToUtf8(std::size_t count)
+    {
+        const sf::String string(getUtf32Text());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string utf8;
+            sf::Utf32::toUtf8(string.begin(), string.end(), std::back_inserter(utf8));
+            keep(utf8.size());
+        }
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void addSystemBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+    Benchmark list[] =
+    {
+        {"system/utf8_to_utf32",    "characters", textLength, false, &utf8ToUtf32},
+        {"system/utf32_to_utf8",    "characters", textLength, false, &utf32ToUtf8},
+        {"system/string_from_utf8", "characters", textLength, false, &stringFromUtf8},
+        {"system/string_from_ansi", "characters", textLength, false, &stringFromAnsi},
+        {"system/string_to_utf8",   "characters", textLength, false, &stringToUtf8}
+    };
+    benchmarks.insert(benchmarks.end(), list, list + sizeof(list) / sizeof(*list));
+}
@@ -0,0 +1,181 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System.hpp>
+#include <iostream>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+
+namespace
+{
+    // Number of elements transferred by each producer
+    const std::size_t elementCount = 1000000;
+
+    // Number of slots of the lock-free queues
+    const std::size_t capacity = 1024;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Unbounded std::queue protected by a mutex, as a reference
+///
+////////////////////////////////////////////////////////////
+class LockedQueue
+{
+public :
+
+    explicit LockedQueue(std::size_t)
+    {
+    }
+
+    bool push(std::size_t value)
+    {
+        sf::Lock lock(m_mutex);
+        m_queue.push(value);
+        return true;
+    }
+
+    bool pop(std::size_t& value)
+    {
+        sf::Lock lock(m_mutex);
+        if (m_queue.empty())
+            return false;
+
+        value = m_queue.front();
+        m_queue.pop();
+        return true;
+    }
+
+private :
+
+    sf::Mutex               m_mutex;
+    std::queue<std::size_t> m_queue;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Push elementCount values into the queue, yielding while it is full
+///
+////////////////////////////////////////////////////////////
+template <typename Queue>
+struct Producer
+{
+    void operator()() const
+    {
+        for (std::size_t i = 1; i <= elementCount; ++i)
+        {
+            while (!queue->push(i))
+                sf::sleep(sf::Time::Zero);
+        }
+    }
+
+    Queue* queue;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Pop values from the queue until the expected total is reached
+///
+////////////////////////////////////////////////////////////
+template <typename Queue>
+struct Consumer
+{
+    void operator()() const
+    {
+        std::size_t value;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            while (!queue->pop(value))
+                sf::sleep(sf::Time::Zero);
+
+            *sum += value;
+        }
+    }
+
+    Queue*              queue;
+    std::size_t         count;
+    unsigned long long* sum;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Measure the throughput of a queue with the given number of
+/// producers and consumers, in millions of elements per second
+///
+////////////////////////////////////////////////////////////
+template <typename Queue>
+double measure(unsigned int producers, unsigned int consumers)
+{
+    Queue queue(capacity);
+    std::vector<unsigned long long> sums(consumers, 0);
+    std::vector<sf::Thread*> threads;
+
+    // Split the elements evenly between the consumers
+    const std::size_t total = elementCount * producers;
+    for (unsigned int i = 0; i < consumers; ++i)
+    {
+        Consumer<Queue> consumer = {&queue, total / consumers + (i < total % consumers ? 1 : 0), &sums[i]};
+        threads.push_back(new sf::Thread(consumer));
+    }
+    for (unsigned int i = 0; i < producers; ++i)
+    {
+        Producer<Queue> producer = {&queue};
+        threads.push_back(new sf::Thread(producer));
+    }
+
+    sf::Clock clock;
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i]->launch();
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+    double seconds = clock.getElapsedTime().asSeconds();
+
+    // Check that every element went through exactly once
+    unsigned long long sum = 0;
+    for (unsigned int i = 0; i < consumers; ++i)
+        sum += sums[i];
+    if (sum != producers * (static_cast<unsigned long long>(elementCount) * (elementCount + 1) / 2))
+        std::cout << "error: elements were lost or duplicated" << std::endl;
+
+    return total / seconds / 1000000.0;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "Throughput of " << elementCount << " elements per producer, in millions of elements per second" << std::endl;
+    std::cout << "(hardware threads: " << sf::ThreadPool::getHardwareConcurrency() << ", lock-free queues of " << capacity << " slots)" << std::endl;
+    std::cout << std::setw(12) << "threads" << std::setw(12) << "queue" << std::setw(12) << "locked" << std::setw(12) << "speedup" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Single producer, single consumer
+    double spsc   = measure<sf::SpscQueue<std::size_t> >(1, 1);
+    double locked = measure<LockedQueue>(1, 1);
+    std::cout << std::setw(12) << "1P/1C spsc" << std::setw(12) << spsc << std::setw(12) << locked << std::setw(12) << spsc / locked << std::endl;
+
+    // Several producers and consumers
+    for (unsigned int threads = 1; threads <= 4; threads *= 2)
+    {
+        double mpmc = measure<sf::MpmcQueue<std::size_t> >(threads, threads);
+        locked = measure<LockedQueue>(threads, threads);
+        std::ostringstream label;
+        label << threads << "P/" << threads << "C mpmc";
+        std::cout << std::setw(12) << label.str() << std::setw(12) << mpmc << std::setw(12) << locked << std::setw(12) << mpmc / locked << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
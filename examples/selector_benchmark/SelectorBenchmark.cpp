@@ -0,0 +1,168 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+
+namespace
+{
+    // Number of clients that send a message at each round
+    const std::size_t sendersPerRound = 8;
+
+    // Number of rounds measured for each mode
+    const int rounds = 2000;
+
+    // Ways of finding out the sockets to read
+    enum Dispatch
+    {
+        ScanAll,       // call isReady on every socket
+        ReadyList,     // iterate over getReadySocket
+        ReadyListEdge  // same, in edge-triggered mode
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+/// Open connections on the loopback interface until there
+/// are \a count of them; returns false if the system refuses
+///
+////////////////////////////////////////////////////////////
+bool openConnections(sf::TcpListener& listener, unsigned short port, std::vector<sf::TcpSocket*>& clients, std::vector<sf::TcpSocket*>& peers, std::size_t count)
+{
+    while (clients.size() < count)
+    {
+        sf::TcpSocket* client = new sf::TcpSocket;
+        sf::TcpSocket* peer = new sf::TcpSocket;
+        if ((client->connect(sf::IpAddress::LocalHost, port) != sf::Socket::Done) || (listener.accept(*peer) != sf::Socket::Done))
+        {
+            delete client;
+            delete peer;
+            return false;
+        }
+
+        clients.push_back(client);
+        peers.push_back(peer);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the average time of a round (sends, wait and
+/// dispatch of the messages) with the given dispatch method
+///
+////////////////////////////////////////////////////////////
+double measure(std::vector<sf::TcpSocket*>& clients, std::vector<sf::TcpSocket*>& peers, Dispatch dispatch)
+{
+    sf::SocketSelector selector;
+    selector.setTriggerMode(dispatch == ReadyListEdge ? sf::SocketSelector::EdgeTriggered : sf::SocketSelector::LevelTriggered);
+    for (std::size_t i = 0; i < peers.size(); ++i)
+    {
+        peers[i]->setBlocking(dispatch != ReadyListEdge);
+        selector.add(*peers[i]);
+    }
+
+    char buffer[64];
+    std::size_t received = 0;
+    std::size_t next = 0;
+    std::size_t messages = 0;
+
+    sf::Clock clock;
+    for (int round = 0; round < rounds; ++round)
+    {
+        // A few clients send a byte
+        for (std::size_t i = 0; i < sendersPerRound; ++i)
+        {
+            next = (next + 7919) % clients.size();
+            clients[next]->send("x", 1);
+        }
+
+        // Wait and read everything that arrived
+        std::size_t pending = sendersPerRound;
+        while (pending > 0 && selector.wait(sf::seconds(1)))
+        {
+            if (dispatch == ScanAll)
+            {
+                for (std::size_t i = 0; i < peers.size(); ++i)
+                {
+                    if (selector.isReady(*peers[i]) && (peers[i]->receive(buffer, sizeof(buffer), received) == sf::Socket::Done))
+                        pending -= std::min(pending, received);
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+                {
+                    sf::TcpSocket* peer = static_cast<sf::TcpSocket*>(selector.getReadySocket(i));
+
+                    // In edge-triggered mode the socket must be drained
+                    while (peer->receive(buffer, sizeof(buffer), received) == sf::Socket::Done)
+                    {
+                        pending -= std::min(pending, received);
+                        if (dispatch != ReadyListEdge)
+                            break;
+                    }
+                }
+            }
+        }
+        messages += sendersPerRound - pending;
+    }
+    double microseconds = static_cast<double>(clock.getElapsedTime().asMicroseconds());
+
+    if (messages != rounds * sendersPerRound)
+        std::cout << "(lost " << rounds * sendersPerRound - messages << " messages) ";
+
+    return microseconds / rounds;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Choose an arbitrary port for opening sockets
+    const unsigned short port = 50002;
+
+    sf::TcpListener listener;
+    if (listener.listen(port) != sf::Socket::Done)
+        return EXIT_FAILURE;
+
+    std::cout << "Average time of a round of " << sendersPerRound << " messages (send + wait + receive), in microseconds" << std::endl;
+    std::cout << std::setw(12) << "connections" << std::setw(16) << "isReady scan" << std::setw(16) << "ready list" << std::setw(16) << "edge-triggered" << std::endl;
+
+    std::vector<sf::TcpSocket*> clients;
+    std::vector<sf::TcpSocket*> peers;
+    const std::size_t counts[] = {100, 500, 1000, 2000, 5000, 10000};
+    for (std::size_t i = 0; i < sizeof(counts) / sizeof(*counts); ++i)
+    {
+        if (!openConnections(listener, port, clients, peers, counts[i]))
+        {
+            std::cout << "Failed to open " << counts[i] << " connections, stopped at " << clients.size()
+                      << " (raise the limit of open files, e.g. ulimit -n 32768)" << std::endl;
+            break;
+        }
+
+        std::cout << std::setw(12) << counts[i] << std::fixed << std::setprecision(1);
+        std::cout << std::setw(16) << measure(clients, peers, ScanAll);
+        std::cout << std::setw(16) << measure(clients, peers, ReadyList);
+        std::cout << std::setw(16) << measure(clients, peers, ReadyListEdge) << std::endl;
+    }
+
+    for (std::size_t i = 0; i < clients.size(); ++i)
+    {
+        delete clients[i];
+        delete peers[i];
+    }
+
+    return EXIT_SUCCESS;
+}
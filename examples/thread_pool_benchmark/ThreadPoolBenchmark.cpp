@@ -0,0 +1,104 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace
+{
+    // Size of the processed image
+    const std::size_t width  = 2048;
+    const std::size_t height = 2048;
+
+    // Number of times the image is processed for each measure
+    const int passes = 10;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Image processing job: blur a row of the source image
+/// horizontally and apply a gamma curve to it
+///
+////////////////////////////////////////////////////////////
+struct ProcessRow
+{
+    void operator()(std::size_t y) const
+    {
+        const float* in = &(*source)[y * width];
+        float* out = &(*destination)[y * width];
+        for (std::size_t x = 1; x < width - 1; ++x)
+            out[x] = std::pow((in[x - 1] + in[x] * 2.f + in[x + 1]) * 0.25f, 1.f / 2.2f);
+    }
+
+    const std::vector<float>* source;
+    std::vector<float>*       destination;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Measure the average time of a pass over the image, in
+/// milliseconds; a null pool runs the loop in the calling thread
+///
+////////////////////////////////////////////////////////////
+double measure(sf::ThreadPool* pool, ProcessRow job)
+{
+    sf::Clock clock;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        if (pool)
+        {
+            pool->parallelFor(0, height, job);
+        }
+        else
+        {
+            for (std::size_t y = 0; y < height; ++y)
+                job(y);
+        }
+    }
+
+    return clock.getElapsedTime().asSeconds() * 1000.0 / passes;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<float> source(width * height);
+    std::vector<float> destination(width * height);
+    for (std::size_t i = 0; i < source.size(); ++i)
+        source[i] = static_cast<float>(std::rand()) / RAND_MAX;
+
+    ProcessRow job = {&source, &destination};
+
+    // Measure with one worker per hardware thread, and at least 4 of them to show the overhead
+    unsigned int maxWorkers = std::max(sf::ThreadPool::getHardwareConcurrency(), 4u);
+
+    std::cout << "Average time of a pass over a " << width << "x" << height << " image, in milliseconds" << std::endl;
+    std::cout << "(hardware threads: " << sf::ThreadPool::getHardwareConcurrency() << ", the calling thread also runs chunks)" << std::endl;
+    std::cout << std::setw(12) << "workers" << std::setw(12) << "time" << std::setw(12) << "speedup" << std::endl;
+
+    double serial = measure(NULL, job);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(12) << "serial" << std::setw(12) << serial << std::setw(12) << 1.0 << std::endl;
+
+    for (unsigned int workers = 1; workers <= maxWorkers; ++workers)
+    {
+        sf::ThreadPool pool(workers);
+        double time = measure(&pool, job);
+        std::cout << std::setw(12) << workers << std::setw(12) << time << std::setw(12) << serial / time << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
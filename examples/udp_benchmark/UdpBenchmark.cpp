@@ -0,0 +1,120 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+
+namespace
+{
+    // Number of clients receiving a state update at each tick
+    const std::size_t clientCount = 200;
+
+    // Number of datagrams sent before reading them back, small enough
+    // to fit in the receive buffer of the system
+    const std::size_t burstSize = 50;
+
+    // Number of ticks measured for each mode
+    const int ticks = 2000;
+
+    // Ways of sending and receiving the datagrams
+    enum Mode
+    {
+        Single, // one call per datagram
+        Batched // one call per array of datagrams
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the number of datagrams per second exchanged on
+/// the loopback interface: at each tick the server sends one
+/// datagram per client, which are received back by bursts
+///
+////////////////////////////////////////////////////////////
+double measure(sf::UdpSocket& sender, sf::UdpSocket& receiver, unsigned short port, std::size_t payload, Mode mode)
+{
+    std::vector<char> data(payload, 'x');
+    std::vector<sf::UdpSocket::Datagram> outgoing(clientCount);
+    for (std::size_t i = 0; i < clientCount; ++i)
+    {
+        outgoing[i].packet.append(&data[0], payload);
+        outgoing[i].remoteAddress = sf::IpAddress::LocalHost;
+        outgoing[i].remotePort = port;
+    }
+    std::vector<sf::UdpSocket::Datagram> incoming(burstSize);
+
+    std::size_t total = 0;
+
+    sf::Clock clock;
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        for (std::size_t first = 0; first < clientCount; first += burstSize)
+        {
+            std::size_t count = 0;
+            if (mode == Single)
+            {
+                for (std::size_t i = first; i < first + burstSize; ++i)
+                    sender.send(outgoing[i].packet, outgoing[i].remoteAddress, outgoing[i].remotePort);
+
+                sf::UdpSocket::Datagram& datagram = incoming[0];
+                while ((count < burstSize) && (receiver.receive(datagram.packet, datagram.remoteAddress, datagram.remotePort) == sf::Socket::Done))
+                    count++;
+            }
+            else
+            {
+                std::size_t sent = 0;
+                sender.send(&outgoing[first], burstSize, sent);
+
+                std::size_t received = 0;
+                while ((count < burstSize) && (receiver.receive(&incoming[count], burstSize - count, received) == sf::Socket::Done))
+                    count += received;
+            }
+            total += count;
+        }
+    }
+    double seconds = clock.getElapsedTime().asSeconds();
+
+    if (total != ticks * clientCount)
+        std::cout << "(lost " << ticks * clientCount - total << " datagrams) ";
+
+    return total / seconds;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Choose an arbitrary port for opening sockets
+    const unsigned short port = 50003;
+
+    sf::UdpSocket sender;
+    sf::UdpSocket receiver;
+    if ((sender.bind(sf::Socket::AnyPort) != sf::Socket::Done) || (receiver.bind(port) != sf::Socket::Done))
+        return EXIT_FAILURE;
+
+    // The receiver must not wait if some datagrams were dropped
+    receiver.setBlocking(false);
+
+    std::cout << "Datagrams per second, " << clientCount << " datagrams per tick in bursts of " << burstSize << " (send + receive)" << std::endl;
+    std::cout << std::setw(12) << "payload" << std::setw(16) << "single" << std::setw(16) << "batched" << std::endl;
+
+    const std::size_t payloads[] = {16, 128, 512, 1200};
+    for (std::size_t i = 0; i < sizeof(payloads) / sizeof(*payloads); ++i)
+    {
+        std::cout << std::setw(12) << payloads[i] << std::fixed << std::setprecision(0);
+        std::cout << std::setw(16) << measure(sender, receiver, port, payloads[i], Single);
+        std::cout << std::setw(16) << measure(sender, receiver, port, payloads[i], Batched) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
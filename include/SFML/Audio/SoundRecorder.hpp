@@ -29,6 +29,8 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <vector>
@@ -253,10 +255,18 @@ private :
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the capturing thread and wait for it to finish
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopThread();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     Thread             m_thread;             ///< Thread running the background recording task
+    Mutex              m_threadMutex;        ///< Mutex protecting the wake up of the thread
+    ConditionVariable  m_threadCondition;    ///< Condition notified to wake up the thread when the capture is stopped
     std::vector<Int16> m_samples;            ///< Buffer to store captured samples
     unsigned int       m_sampleRate;         ///< Sample rate
     sf::Time           m_processingInterval; ///< Time period between calls to onProcessSamples
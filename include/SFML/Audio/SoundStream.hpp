@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <cstdlib>
@@ -281,15 +283,17 @@ private :
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    bool          m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    Thread            m_thread;                  ///< Thread running the background tasks
+    Mutex             m_threadMutex;             ///< Mutex protecting the wake up of the thread
+    ConditionVariable m_threadCondition;         ///< Condition notified to wake up the thread when the stream is stopped
+    bool              m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
+    unsigned int      m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
+    unsigned int      m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int      m_sampleRate;              ///< Frequency (samples / second)
+    Uint32            m_format;                  ///< Format of the internal sound buffers
+    bool              m_loop;                    ///< Loop flag (true to loop, false to play once)
+    Uint64            m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
+    bool              m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
 };
 
 } // namespace sf
@@ -34,6 +34,7 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -60,6 +61,31 @@ public :
 		std::string family; ///< The font family
 	};
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the texture of a character size
+    ///
+    ////////////////////////////////////////////////////////////
+    struct AtlasStatistics
+    {
+        Vector2u     textureSize; ///< Current size of the texture, in pixels
+        unsigned int glyphCount;  ///< Number of glyphs currently stored in the texture
+        float        occupancy;   ///< Ratio of the texture area covered by glyphs, in range [0, 1]
+        unsigned int evictions;   ///< Number of glyphs evicted from the texture so far
+        unsigned int repacks;     ///< Number of times the texture was repacked after evictions
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of consecutive code points
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Range
+    {
+        Range(Uint32 rangeFirst, Uint32 rangeLast) : first(rangeFirst), last(rangeLast) {}
+
+        Uint32 first; ///< First code point of the range
+        Uint32 last;  ///< Last code point of the range (included)
+    };
+
 public :
 
     ////////////////////////////////////////////////////////////
@@ -161,6 +187,67 @@ public :
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded the first time that they are
+    /// requested, which can make the first frame displaying
+    /// new characters slow. This function loads all the glyphs
+    /// of the given ranges at once: they are rasterized in
+    /// parallel on worker threads, then added to the texture
+    /// of the character size with a single update.
+    /// Rasterizing in parallel requires a font loaded from a
+    /// file or from memory; fonts loaded from a stream are
+    /// rasterized on the calling thread.
+    ///
+    /// \param ranges        Ranges of code points to load
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold version or the regular one?
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preload(const std::vector<Range>& ranges, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the loaded glyphs to a cache file
+    ///
+    /// The file contains the textures of all the character sizes,
+    /// the metrics of their glyphs and the kerning of every pair
+    /// of their characters. It is identified by a hash of the
+    /// font data, so that it can only be loaded back by the same
+    /// font. Its content is stored in the byte order of the
+    /// machine that saved it.
+    ///
+    /// \param filename Path of the cache file to write
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see loadAtlasCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveAtlasCache(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load glyphs from a cache file
+    ///
+    /// The glyphs and kerning pairs stored in the file are then
+    /// available without any call to FreeType. The font must be
+    /// loaded before calling this function, and the cache file
+    /// must have been saved by the same font. The character
+    /// sizes present in the file replace the ones that are
+    /// already loaded, so it is best to call this function
+    /// right after loading the font.
+    ///
+    /// \param filename Path of the cache file to read
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see saveAtlasCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadAtlasCache(const std::string& filename);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -206,6 +293,70 @@ public :
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the size of the glyph textures
+    ///
+    /// Every character size has its own texture, which grows as
+    /// new glyphs are loaded. By default it can grow up to the
+    /// maximum texture size, and glyphs are never removed from it.
+    /// When a budget is set, a texture that reaches \a maxTextureSize
+    /// and is full evicts the glyphs that were not retrieved during
+    /// the last \a unusedFrames frames, and repacks the remaining
+    /// ones. If this is not enough, all the glyphs that were not
+    /// retrieved during the current frame are evicted. The glyphs
+    /// retrieved during the current frame are never evicted nor
+    /// moved, since they may already be used by geometry. Evicted
+    /// glyphs are loaded again when they are requested.
+    ///
+    /// Frames are counted with advanceFrame.
+    ///
+    /// \param maxTextureSize Maximum width and height of each texture, or 0 for no budget
+    /// \param unusedFrames   Number of frames after which an unused glyph can be evicted
+    ///
+    /// \see advanceFrame, getAtlasStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAtlasBudget(unsigned int maxTextureSize, unsigned int unusedFrames);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the font that a new frame starts
+    ///
+    /// This function is used to know which glyphs were used
+    /// recently, when a texture budget is set. It should be
+    /// called once per frame.
+    ///
+    /// \see setAtlasBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void advanceFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the texture of a character size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Size, occupancy and eviction counters of the texture
+    ///
+    /// \see setAtlasBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    AtlasStatistics getAtlasStatistics(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the revision of the texture of a character size
+    ///
+    /// The revision changes every time glyphs are moved within
+    /// the texture, which invalidates their texture rectangles.
+    /// It is mainly used internally by sf::Text, to know when
+    /// its geometry must be rebuilt.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Current revision of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getAtlasRevision(unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -219,22 +370,60 @@ public :
 private :
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Structure defining a segment of the skyline of a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SkylineNode
+    {
+        SkylineNode(unsigned int nodeX, unsigned int nodeY, unsigned int nodeWidth) : x(nodeX), y(nodeY), width(nodeWidth) {}
+
+        unsigned int x;     ///< Left position of the segment
+        unsigned int y;     ///< Top of the free space above the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a glyph stored in a page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CachedGlyph
+    {
+        CachedGlyph(const Glyph& loaded, unsigned int frame) : glyph(loaded), lastUse(frame), resident(true) {}
+
+        Glyph        glyph;    ///< The glyph
+        unsigned int lastUse;  ///< Last frame in which the glyph was retrieved
+        bool         resident; ///< Is the glyph stored in the texture, or was it evicted?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Hash table with open addressing, mapping integer keys to values
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    template <typename T, typename Key = Uint32>
+    struct HashTable
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+        struct Entry
+        {
+            Key  key;   ///< Key of the entry
+            T    value; ///< Value of the entry
+            bool used;  ///< Does the entry hold a value?
+        };
+
+        HashTable() : count(0) {}
 
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        T*   find(Key key) const;
+        void insert(Key key, const T& value);
+        void clear();
+
+        std::vector<Entry> entries; ///< Slots of the table (the size is a power of two)
+        std::size_t        count;   ///< Number of used slots
     };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint32, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    typedef HashTable<Uint32>      GlyphTable;   ///< Table mapping a codepoint (and the bold flag) to the index + 1 of its glyph
+    typedef HashTable<int, Uint64> KerningTable; ///< Table mapping a pair of code points (first << 32 | second) to their kerning
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -244,10 +433,21 @@ private :
     {
         Page();
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        sf::Texture      texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        void resetSkyline();
+        void rebuildSkyline();
+
+        std::deque<CachedGlyph>  glyphs;        ///< Loaded glyphs (a deque, so that references to them remain valid)
+        Uint32                   latin[2][256]; ///< Index + 1 of the regular and bold glyphs of the first 256 code points, or 0
+        GlyphTable               table;         ///< Table mapping the other code points to the index + 1 of their glyph
+        sf::Texture              texture;       ///< Texture containing the pixels of the glyphs
+        std::vector<SkylineNode> skyline;       ///< Top of the occupied area of the texture, from left to right
+        unsigned int             usedArea;      ///< Area of the texture covered by glyphs
+        unsigned int             evictions;     ///< Number of glyphs evicted so far
+        unsigned int             repacks;       ///< Number of repacks of the texture so far
+        unsigned int             revision;      ///< Incremented every time glyphs are moved within the texture
+        std::vector<Int16>       asciiKerning;  ///< Kerning of the pairs of ASCII characters (first * 128 + second), allocated on first use
+        KerningTable             kerning;       ///< Kerning of the other pairs of characters already looked up
+        GlyphTable               kerningChars;  ///< Code points loaded from a cache file, whose pairs missing from the tables have no kerning
     };
 
     ////////////////////////////////////////////////////////////
@@ -256,6 +456,28 @@ private :
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of glyphs of a character size, creating it if needed
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of glyphs of the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the entry of a glyph in the index tables of a page, creating it if needed
+    ///
+    /// \param page      Page of glyphs to search in
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Regular or bold version of the glyph?
+    ///
+    /// \return Pointer to the index + 1 of the glyph in the page, or to 0 if it was never loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32* findGlyphIndex(Page& page, Uint32 codePoint, bool bold) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -280,6 +502,32 @@ private :
     ////////////////////////////////////////////////////////////
     IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Place a rectangle on the skyline of a page, without resizing the texture
+    ///
+    /// \param page   Page of glyphs to search in
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the rectangle within the texture
+    ///
+    /// \return True if the rectangle fits in the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool packGlyphRect(Page& page, unsigned int width, unsigned int height, IntRect& rect) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the glyphs that were not used recently and repack the other ones
+    ///
+    /// The glyphs used in the current frame are never evicted nor moved.
+    ///
+    /// \param page        Page of glyphs to clean
+    /// \param evictRecent Evict all the glyphs not used in the current frame, even recent ones
+    ///
+    /// \return True if glyphs were evicted, false if there was nothing to evict
+    ///
+    ////////////////////////////////////////////////////////////
+    bool evictGlyphs(Page& page, bool evictRecent) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
     ///
@@ -290,10 +538,31 @@ private :
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute a hash of the font data, to identify cache files
+    ///
+    /// \return 64-bit FNV-1a hash of the font file contents
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 computeFontHash() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the kerning offset of two glyphs from FreeType, bypassing the cache
+    ///
+    /// \param first         Unicode code point of the first character
+    /// \param second        Unicode code point of the second character
+    /// \param characterSize Reference character size
+    ///
+    /// \return Kerning value for \a first and \a second, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    int loadKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, Page> PageTable;  ///< Table mapping a character size to its page (texture)
+    typedef HashTable<Page*>             PageLookup; ///< Table mapping a character size to its page, for fast lookups
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -303,8 +572,15 @@ private :
     void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
     int*                       m_refCount;    ///< Reference counter used by implicit sharing
     Info					   m_info;		  ///< Information about the font
+    std::string                m_fileName;    ///< File the font was loaded from, if any (used to open more faces)
+    const void*                m_memoryData;  ///< Memory the font was loaded from, if any (used to open more faces)
+    std::size_t                m_memorySize;  ///< Size of the memory the font was loaded from
 	mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable PageLookup         m_pageLookup;  ///< Hash table pointing to the pages of m_pages
+    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding the alpha values of a glyph before being written to the texture
+    unsigned int               m_atlasBudget; ///< Maximum size of the textures, or 0 for no budget
+    unsigned int               m_unusedFrames; ///< Number of frames after which an unused glyph can be evicted
+    unsigned int               m_frame;       ///< Current frame, as counted by advanceFrame
 };
 
 } // namespace sf
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2012 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GIFDECODER_HPP
+#define SFML_GIFDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+struct GifFileType;
+
+namespace sf
+{
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Streaming decoder for animated gif files
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GifDecoder : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Frame disposal modes, as stored in the file
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Disposal
+    {
+        Unspecified     = 0, ///< No disposal specified, the frame is left in place
+        DoNotDispose    = 1, ///< The frame is left in place
+        ClearToColor    = 2, ///< The frame area is cleared before the next frame
+        RestorePrevious = 3  ///< The frame area is restored to its previous content
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GifDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GifDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a gif file on disk for decoding
+    ///
+    /// Only the header of the file is read by this function,
+    /// frames are decoded one by one by readNextFrame.
+    ///
+    /// \param filename Path of the gif file to open
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    /// \see openFromMemory, openFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a gif file in memory for decoding
+    ///
+    /// Since the frames are decoded on demand, the \a data must
+    /// remain available as long as the decoder is reading it.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    /// \see openFromFile, openFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a gif file from a custom stream for decoding
+    ///
+    /// Since the frames are decoded on demand, the \a stream must
+    /// remain alive as long as the decoder is reading it.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    /// \see openFromFile, openFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the current file, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the next frame of the animation
+    ///
+    /// The returned image is the whole canvas after the frame
+    /// has been composited over the previous ones, according to
+    /// the disposal mode of the previous frame, the frame offset
+    /// and its local color map. The file is read only once:
+    /// each call continues where the previous one stopped.
+    ///
+    /// \param frame Image to fill with the composited canvas
+    ///
+    /// \return True if a frame was decoded, false at the end of the file or on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readNextFrame(Image& frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the next frame of the animation without copying it
+    ///
+    /// Same as readNextFrame(Image&), but the canvas stays inside
+    /// the decoder; use getPixelsPtr to access it.
+    ///
+    /// \return True if a frame was decoded, false at the end of the file or on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readNextFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the canvas (size of every frame)
+    ///
+    /// \return Size of the canvas, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the current canvas
+    ///
+    /// The canvas is made of getSize().x * getSize().y RGBA pixels
+    /// and is overwritten by the next call to readNextFrame.
+    ///
+    /// \return Read-only pointer to the array of pixels, or null if no frame was read yet
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixelsPtr() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames decoded so far
+    ///
+    /// \return Number of frames read by readNextFrame since the file was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the disposal mode of the last decoded frame
+    ///
+    /// \return Disposal mode, 0=unspecified, 1=do_not_dispose, 2=clear_to_color, 3=restore_previous_content
+    ///
+    ////////////////////////////////////////////////////////////
+    int getFrameDisposal() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the display delay of the last decoded frame
+    ///
+    /// \return Time to wait before displaying the next frame
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameDelay() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the header of a freshly opened gif file
+    ///
+    /// \param file Handle returned by giflib, or null if opening failed
+    /// \param error Error code returned by giflib
+    /// \param name Name of the source, for error messages
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initialize(GifFileType* file, int error, const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Dispose the last frame from the canvas
+    ///
+    ////////////////////////////////////////////////////////////
+    void disposeFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the current image descriptor onto the canvas
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decodeImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Data and callback for opening from memory
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MemorySource
+    {
+        const Uint8* data;
+        std::size_t  size;
+        std::size_t  offset;
+
+        static int read(GifFileType* file, Uint8* buffer, int size);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Callback for opening from a custom stream
+    ///
+    ////////////////////////////////////////////////////////////
+    static int readFromStream(GifFileType* file, Uint8* buffer, int size);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    GifFileType*       m_file;         ///< giflib handle of the opened file
+    MemorySource       m_memory;       ///< Memory source, when opened with openFromMemory
+    InputStream*       m_stream;       ///< Stream source, when opened with openFromStream
+    Vector2u           m_size;         ///< Size of the canvas
+    std::vector<Uint8> m_canvas;       ///< Composited RGBA canvas
+    std::vector<Uint8> m_previous;     ///< Canvas saved for frames using the RestorePrevious disposal
+    std::vector<Uint8> m_line;         ///< Color indices of the line being decoded
+    unsigned int       m_frameCount;   ///< Number of frames decoded so far
+    int                m_disposal;     ///< Disposal mode of the last decoded frame
+    int                m_delay;        ///< Delay of the last decoded frame, in 1/100 seconds
+    int                m_transparent;  ///< Transparent color index of the pending frame, or -1
+    IntRect            m_frameRect;    ///< Area covered by the last decoded frame
+};
+
+} // namespace sf
+
+
+#endif // SFML_GIFDECODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GifDecoder
+/// \ingroup graphics
+///
+/// sf::GifDecoder reads an animated gif in a single pass and
+/// hands out the frames one after the other, already composited
+/// onto the full canvas. Memory usage is bounded by the size of
+/// one or two canvases, whatever the number of frames.
+///
+/// Usage example:
+/// \code
+/// sf::GifDecoder decoder;
+/// if (!decoder.openFromFile("animation.gif"))
+///     return -1;
+///
+/// sf::Image frame;
+/// while (decoder.readNextFrame(frame))
+/// {
+///     // do something with the frame, its delay is decoder.getFrameDelay()
+/// }
+/// \endcode
+///
+/// \see sf::GifReader, sf::SlideShow
+///
+////////////////////////////////////////////////////////////
@@ -28,17 +28,15 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include "Export.hpp"
-
-
-
-
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <string>
 
 
 namespace sf
 {
-
-class Image;
+class GifDecoder;
+class InputStream;
 
 ////////////////////////////////////////////////////////////
 /// \brief The GifReader class, designed to read animated gif files.
@@ -80,6 +78,9 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief convert gif frame number into array of pixels, make sure to free array when done
     ///
+    /// The file is decoded up to the requested frame on every call,
+    /// use sf::GifDecoder to read the frames sequentially.
+    ///
     /// \param int width of frame
     ///
     /// \param int height of frame
@@ -96,6 +97,9 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief load gif frame number into Image passed by reference
     ///
+    /// The file is decoded up to the requested frame on every call,
+    /// use sf::GifDecoder to read the frames sequentially.
+    ///
     /// \param Image file to load frame into
     ///
     /// \param int the frame to retrieve
@@ -155,6 +159,33 @@ public :
     bool loadGifAnimationFromFile(const std::string& filename);
 
     ////////////////////////////////////////////////////////////
+    /// \brief Load the animated image from a file in memory into this object
+    ///
+    /// Same as loadGifAnimationFromFile, but the gif file is read from memory.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGifAnimationFromMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the animated image from a custom stream into this object
+    ///
+    /// Same as loadGifAnimationFromFile, but the gif file is read from a stream.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGifAnimationFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
     /// \brief get width and height of frame
     ///
     /// \return Vector2<int>
@@ -181,6 +212,17 @@ public :
 
 
 protected :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode all the frames of an opened decoder into this object
+    ///
+    /// \param decoder Decoder opened on the gif file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGifAnimation(GifDecoder& decoder);
+
     int fwidth, fheight, totalFrames;
 
     //int** frame disposal mode, 0=unspecified, 1=do_not_dispose, 2=clear_to_color, 3=restore_previous_content, it's size is equal to number of frames
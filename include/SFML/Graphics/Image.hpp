@@ -269,6 +269,19 @@ public :
     ////////////////////////////////////////////////////////////
     void setAlpha(unsigned int alpha);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Exchange the contents of this image with another one
+    ///
+    /// Only the internal buffers are exchanged, no pixel is copied,
+    /// so this function is very cheap even for large images.
+    /// Pointers returned by getPixelsPtr() remain valid but
+    /// follow the pixels to the other image.
+    ///
+    /// \param right Image to exchange the contents with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Image& right);
+
 protected :
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RECORDINGRENDERTARGET_HPP
+#define SFML_RECORDINGRENDERTARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class RenderBackendRecorder;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Render target which records the rendering commands
+///        instead of executing them
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RecordingRenderTarget : public RenderTarget
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DrawCall
+    {
+        PrimitiveType  type;        ///< Type of the primitives
+        unsigned int   firstVertex; ///< Index of the first vertex in the recorded vertices
+        unsigned int   vertexCount; ///< Number of vertices
+        const Texture* texture;     ///< Texture bound at the time of the draw
+        const Shader*  shader;      ///< Shader bound at the time of the draw
+        BlendMode      blendMode;   ///< Blending mode at the time of the draw
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the recorded commands
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Counters
+    {
+        unsigned int drawCalls;        ///< Number of draw calls
+        unsigned int vertexCount;      ///< Number of vertices drawn
+        unsigned int clears;           ///< Number of clears
+        unsigned int viewChanges;      ///< Number of viewport and projection changes
+        unsigned int transformChanges; ///< Number of model-view matrix changes
+        unsigned int blendModeChanges; ///< Number of blending mode changes
+        unsigned int textureChanges;   ///< Number of texture bindings
+        unsigned int shaderChanges;    ///< Number of shader bindings
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the target with a given size
+    ///
+    /// \param width  Width of the target, in pixels
+    /// \param height Height of the target, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    RecordingRenderTarget(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the rendering region of the target
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the recorded commands
+    ///
+    /// \return Counters accumulated since the last call to clearRecording
+    ///
+    ////////////////////////////////////////////////////////////
+    const Counters& getCounters() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the recorded draw calls
+    ///
+    /// \return Draw calls, in submission order
+    ///
+    /// \see getVertices
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<DrawCall>& getDrawCalls() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertices of the recorded draw calls
+    ///
+    /// The positions are transformed by the model-view matrix
+    /// that was active at the time of the draw (but not by the
+    /// view), so they are expressed in world coordinates no
+    /// matter how the render target submitted them.
+    ///
+    /// \return Vertices of all the draw calls, one after the other
+    ///
+    /// \see getDrawCalls
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Vertex>& getVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the recorded commands and reset the counters
+    ///
+    /// The memory used by the recording is kept for reuse.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearRecording();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target for rendering
+    ///
+    /// \param active True to make the target active, false to deactivate it
+    ///
+    /// \return Always true, the target needs no context
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool activate(bool active);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                     m_size;     ///< Size of the target
+    priv::RenderBackendRecorder* m_recorder; ///< Backend which records the commands (owned by the base class)
+};
+
+} // namespace sf
+
+
+#endif // SFML_RECORDINGRENDERTARGET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RecordingRenderTarget
+/// \ingroup graphics
+///
+/// sf::RecordingRenderTarget goes through the same code path as
+/// sf::RenderWindow and sf::RenderTexture (states caching, batching,
+/// vertex pre-transformation), but the resulting low-level
+/// commands are recorded instead of being sent to OpenGL.
+/// It requires no window and no OpenGL context, and is therefore
+/// suited to measure the CPU cost of drawing, or to check what
+/// the graphics card would receive, on machines without a GPU.
+///
+/// Since nothing is rendered, the textures and shaders used
+/// with this target are never bound; note however that creating
+/// a sf::Texture, sf::Shader or sf::Font still requires an
+/// OpenGL context.
+///
+/// Usage example:
+/// \code
+/// sf::RecordingRenderTarget target(800, 600);
+/// target.setBatchingEnabled(true);
+///
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     target.draw(sprites[i]);
+/// target.flush();
+///
+/// const sf::RecordingRenderTarget::Counters& counters = target.getCounters();
+/// std::cout << counters.drawCalls << " draw calls, "
+///           << counters.vertexCount << " vertices" << std::endl;
+///
+/// target.clearRecording();
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -38,10 +38,16 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class RenderBackend;
+}
+
 class Drawable;
 
 ////////////////////////////////////////////////////////////
@@ -52,6 +58,16 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public :
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the work sent to OpenGL
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        unsigned int drawCalls;   ///< Number of OpenGL draw calls
+        unsigned int vertexCount; ///< Number of vertices sent to OpenGL
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -247,6 +263,76 @@ public :
     void draw(const Vertex* vertices, unsigned int vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draws which use
+    /// the same texture and blending mode, and no shader, are
+    /// transformed on the CPU and accumulated into a single
+    /// vertex stream, which is sent to OpenGL in one draw call
+    /// when the states change or when the target is displayed.
+    /// Strips, fans and quads are converted to independent
+    /// lines and triangles so that they can be merged.
+    ///
+    /// Since the drawing is deferred, the textures used by
+    /// the pending draws must remain alive and unmodified
+    /// until the batch is flushed (see flush()).
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the pending batched draws to OpenGL
+    ///
+    /// This function is called automatically when the target
+    /// is cleared, displayed or captured, when its view changes
+    /// and around OpenGL states management. You only need to call
+    /// it before issuing your own OpenGL commands, or before
+    /// modifying or destroying a texture that was drawn since
+    /// the last flush.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the work sent to OpenGL
+    ///
+    /// The counters accumulate until resetStatistics is called,
+    /// typically once per frame.
+    ///
+    /// \return Draw call and vertex counters
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the draw call and vertex counters to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -331,6 +417,22 @@ protected :
     ////////////////////////////////////////////////////////////
     RenderTarget();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the target with a custom rendering backend
+    ///
+    /// \param backend Backend which executes the rendering commands (the target takes ownership of it)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit RenderTarget(priv::RenderBackend* backend);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the backend which executes the rendering commands
+    ///
+    /// \return Rendering backend of the target
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::RenderBackend* getRenderBackend() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Performs the common initialization step after creation
     ///
@@ -340,8 +442,45 @@ protected :
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the pending batched draws to OpenGL before
+    ///        the contents of the target are read
+    ///
+    /// Reading the target back doesn't change what it shows,
+    /// so this function can be called from const functions
+    /// such as RenderWindow::capture.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushBeforeRead() const;
+
 private:
 
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send primitives to OpenGL, bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(const Vertex* vertices, unsigned int vertexCount,
+                        PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform primitives and append them to the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param transform   Transform to apply to the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendToBatch(const Vertex* vertices, unsigned int vertexCount,
+                       PrimitiveType type, const Transform& transform);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -410,12 +549,30 @@ private:
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending batched draws
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        std::vector<Vertex> vertices;    ///< Pre-transformed vertices of the pending draws
+        std::vector<Vertex> transformed; ///< Transformed vertices of the draw being split into the batch
+        PrimitiveType       type;        ///< Type of the primitives (Points, Lines or Triangles)
+        const Texture*      texture;     ///< Texture used by the pending draws
+        Uint64              textureId;   ///< Cache identifier of the texture
+        BlendMode           blendMode;   ///< Blending mode used by the pending draws
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    priv::RenderBackend* m_backend;         ///< Backend which executes the rendering commands
+    View                 m_defaultView;     ///< Default view
+    View                 m_view;            ///< Current view
+    StatesCache          m_cache;           ///< Render states cache
+    bool                 m_batchingEnabled; ///< Are the draw calls batched?
+    Batch                m_batch;           ///< Pending batched draws
+    Statistics           m_statistics;      ///< Counters of the work sent to OpenGL
 };
 
 } // namespace sf
@@ -446,6 +603,13 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
-/// \see sf::RenderWindow, sf::RenderTexture, sf::View
+/// Scenes made of many small entities sharing the same texture
+/// (sprites from an atlas, text, tiles) can be drawn much faster
+/// by enabling the batching of draw calls (setBatchingEnabled):
+/// thousands of sprites then cost a single OpenGL draw call.
+/// The getStatistics function reports the number of draw calls
+/// and vertices actually sent to OpenGL.
+///
+/// \see sf::RenderWindow, sf::RenderTexture, sf::RecordingRenderTarget, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -148,6 +148,16 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window's contents are displayed
+    ///
+    /// This function is called so that derived classes can
+    /// finish rendering the current frame before it is
+    /// shown on screen.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private :
 
     ////////////////////////////////////////////////////////////
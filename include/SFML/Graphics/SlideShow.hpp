@@ -28,25 +28,21 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include "Export.hpp"
-#include <iostream>
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <string>
-#include <map>
-
-
-
-
+#include <vector>
 
 
 namespace sf
 {
-
-class Image;
+class GifDecoder;
+class InputStream;
 
 ////////////////////////////////////////////////////////////
 /// \brief The SlideShow class, designed to display series of images.
 /// Be very careful with SlideShow class, they are heavy weight objects and take up vast amount of computer memory.
-/// SlideShow is also very slow and the image should not be changed more than once every second.
+/// Changing the current slide is cheap, pixels are exchanged between images and never copied.
 ///
 ////////////////////////////////////////////////////////////
 class SFML_GRAPHICS_API SlideShow : public Image
@@ -59,6 +55,8 @@ public :
     ////////////////////////////////////////////////////////////
     SlideShow() : sf::Image()
     {
+        totalSlides = 0;
+        currentSlide = -1;
         sdisposal = 0;
     }
 
@@ -83,15 +81,29 @@ public :
     int getSlideCount()const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief get array of frame disposal modes, these are equal to number of frames
+    /// \brief make a slide the content of this image
     ///
-    /// \param int index of image
+    /// Switching is done in constant time: the pixels of the slide are
+    /// moved into this image instead of being copied, and moved back when
+    /// another slide becomes current. getPixelsPtr() therefore gives direct
+    /// access to the pixels of the current slide, and changes made to this
+    /// image are kept in the slide.
     ///
-    /// \return int array of frame disposal modes, 0=unspecified, 1=do_not_dispose, 2=clear_to_color, 3=restore_previous_content, it's size is equal to number of frames
+    /// \param int index of slide
+    ///
+    /// \return True if index is a valid slide index
     ///
     ////////////////////////////////////////////////////////////
     bool setCurrentSlide(const unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief get the index of the current slide
+    ///
+    /// \return int index of the current slide, -1 if no slide was set
+    ///
+    ////////////////////////////////////////////////////////////
+    int getCurrentSlide()const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
@@ -166,11 +178,48 @@ public :
     ////////////////////////////////////////////////////////////
     bool loadSlidesFromGifFile(const std::string& filename);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load gif animation file in memory into series of slides
+    ///
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSlidesFromGifMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load gif animation from a custom stream into series of slides
+    ///
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSlidesFromGifStream(InputStream& stream);
+
 
 
 protected :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode all the frames of an opened decoder into slides
+    ///
+    /// \param decoder Decoder opened on the gif file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSlidesFromGif(GifDecoder& decoder);
+
     int totalSlides;
 
+    //index of the slide whose pixels are currently held by this image, -1 if none
+    int currentSlide;
+
     //int** slide disposal mode, 0=unspecified, 1=do_not_dispose, 2=clear_to_color, 3=restore_previous_content, it's size is equal to number of slides
     int* sdisposal;
 
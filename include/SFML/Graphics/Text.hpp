@@ -93,6 +93,11 @@ public :
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// The geometry is computed when the text is next drawn or
+    /// measured. Only the lines following the first modified
+    /// character are laid out again, so appending characters or
+    /// editing the end of a long text stays cheap.
+    ///
     /// \param string New string
     ///
     /// \see getString
@@ -266,15 +271,45 @@ public :
     /// in global coordinates (translation, rotation, scale and
     /// origin are applied).
     /// If \a index is out of range, the position of the end of
-    /// the string is returned.
+    /// the string is returned. For bounded texts, the lines
+    /// wrapped to the bounding box are taken into account, and
+    /// the characters that don't fit in it are placed at the end
+    /// of the visible text.
+    ///
+    /// The positions are computed along with the geometry, so
+    /// this function doesn't need to walk through the string.
     ///
     /// \param index Index of the character
     ///
     /// \return Position of the character
     ///
+    /// \see findCharacterIndex
+    ///
     ////////////////////////////////////////////////////////////
     Vector2f findCharacterPos(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index of the character closest to a point
+    ///
+    /// This function is the opposite of findCharacterPos: it finds
+    /// the index of the character whose position is the closest
+    /// to \a point, on the line under it. It is typically used to
+    /// place a cursor where the mouse was clicked. The point is
+    /// in global coordinates. If it is past the end of a line,
+    /// the index of the line break is returned.
+    ///
+    /// The lookup is a binary search in the lines and then in the
+    /// positions of the characters of a line.
+    ///
+    /// \param point Point to test, in global coordinates
+    ///
+    /// \return Index of the character, in [0, getString().getSize()]
+    ///
+    /// \see findCharacterPos
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findCharacterIndex(const Vector2f& point) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the global bounding box of the entity
     ///
@@ -326,18 +361,87 @@ private :
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure that the text's geometry is up to date
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the text's geometry
     ///
+    /// The geometry of the first m_validLength characters is
+    /// kept, the layout resumes from the start of their last line.
+    /// The lines made of the last m_validSuffix characters are
+    /// moved into place once the layout reaches them.
+    ///
     ////////////////////////////////////////////////////////////
-    void updateGeometry();
+    void updateGeometry() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the text's geometry, within confines of
     /// bounding box.
     ///
+    /// Like updateGeometry, the layout resumes from the start of
+    /// the last line (wrapped or not) that is still valid, as long
+    /// as the transform of the text didn't change. The following
+    /// lines are moved into place as long as they stay in the box.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateGeometryBounding() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the text to the corner of its bounding box
+    ///
+    /// This function does nothing if the text is not bounded.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBoundingPosition();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the margin used by the bounded layout
+    ///
+    /// \return The bounding margin, or 0 if it leaves no room for the text
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getEffectiveMargin() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout state at the start of a line of the geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LineState
+    {
+        LineState(std::size_t first, unsigned int vertexCount, const Vector2f& pen, const Vector2f& penGlobal,
+                  float minLeft, float minTop, float maxRight, float maxBottom) :
+        index(first), vertices(vertexCount), position(pen), global(penGlobal), minX(minLeft), minY(minTop), maxX(maxRight), maxY(maxBottom) {}
+
+        std::size_t  index;    ///< Index of the first character of the line
+        unsigned int vertices; ///< Number of vertices generated by the previous lines
+        Vector2f     position; ///< Position of the pen at the start of the line (on the baseline)
+        Vector2f     global;   ///< Last position tested against the bounding box (bounded layout only)
+        float        minX;     ///< Bounds of the line (left)
+        float        minY;     ///< Bounds of the line (top)
+        float        maxX;     ///< Bounds of the line (right)
+        float        maxY;     ///< Bounds of the line (bottom)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append lines of the previous geometry, moved to the current line
+    ///
+    /// The last line state must be the one of \a lines[first],
+    /// at its new index and position.
+    ///
+    /// \param lines     Line states of the previous geometry
+    /// \param first     Index of the first line to move
+    /// \param last      Index of the line where the layout resumes
+    ///                  (lines.size() to move all the lines)
+    /// \param vertices  Vertices of the lines, starting at the first of \a lines
+    /// \param positions Character positions of the lines, starting at the first of \a lines
+    ///
     ////////////////////////////////////////////////////////////
-    void updateGeometryBounding();
+    void moveLines(const std::vector<LineState>& lines, std::size_t first, std::size_t last,
+                   const std::vector<Vertex>& vertices, const std::vector<Vector2f>& positions) const;
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -347,12 +451,20 @@ private :
     unsigned int  m_characterSize; ///< Base size of characters, in pixels
     Uint32        m_style;         ///< Text style (see Style enum)
     Color         m_color;         ///< Text color
-    VertexArray   m_vertices;      ///< Vertex array containing the text's geometry
-    FloatRect     m_bounds;        ///< Bounding rectangle of the text (in local coordinates)
+    mutable VertexArray m_vertices; ///< Vertex array containing the text's geometry
+    mutable FloatRect m_bounds;    ///< Bounding rectangle of the text (in local coordinates)
     FloatRect     m_boundBox;      ///< Bounding box of the text (in global coordinates)
     unsigned int m_boundMargin;   ///< Margin size around bounding box
-    unsigned int m_numBoundChars;  ///< The number of chars currently printed by update geometry
+    mutable unsigned int m_numBoundChars; ///< The number of chars currently printed by update geometry
     bool         m_isBounded;      ///< True if currently in bounded mode
+    mutable unsigned int m_atlasRevision; ///< Revision of the font's texture when the geometry was computed
+    mutable bool m_geometryNeedUpdate; ///< Does the geometry need to be recomputed before being used?
+    mutable std::size_t m_validLength; ///< Number of leading characters whose geometry is still valid
+    mutable std::size_t m_validSuffix; ///< Number of trailing characters whose geometry only has to be moved
+    mutable std::size_t m_layoutLength; ///< Length of the string when the geometry was computed
+    mutable std::vector<LineState> m_lines; ///< Layout state at the start of each line, to resume the geometry from there
+    mutable std::vector<Vector2f>  m_positions; ///< Position of the pen before each laid out character, and after the last one
+    mutable Transform m_layoutTransform; ///< Transform used to wrap the lines of the bounded layout
 };
 
 } // namespace sf
@@ -469,6 +469,57 @@ private :
 
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class Font;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture, optionally with a single alpha channel
+    ///
+    /// Alpha-only textures use a quarter of the memory of RGBA
+    /// textures, and are sampled as white pixels with the stored
+    /// alpha. If the graphics driver cannot sample them as white,
+    /// a regular RGBA texture is created instead.
+    /// The contents of the new texture are undefined.
+    ///
+    /// \param width     Width of the texture
+    /// \param height    Height of the texture
+    /// \param alphaOnly Store only the alpha channel?
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, bool alphaOnly);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from an array of alpha values
+    ///
+    /// The color channels of RGBA textures are set to white.
+    ///
+    /// \param pixels Array of alpha values to copy to the texture, one byte per pixel
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAlpha(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the alpha channel of the texture to an array
+    ///
+    /// \param pixels Array of getSize().x * getSize().y bytes to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void copyAlpha(Uint8* pixels) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the pixels of the texture, without padding and flipping
+    ///
+    /// \param pixels   Array of getSize().x * getSize().y * \a channels bytes to fill
+    /// \param format   OpenGL format of the pixels to read
+    /// \param channels Number of bytes per pixel of \a format
+    ///
+    ////////////////////////////////////////////////////////////
+    void readPixels(Uint8* pixels, unsigned int format, unsigned int channels) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -494,6 +545,7 @@ private :
     bool         m_isSmooth;      ///< Status of the smooth filter
     bool         m_isRepeated;    ///< Is the texture in repeat mode?
     mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    bool         m_isAlphaOnly;   ///< Does the texture store only the alpha channel?
     Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
 };
 
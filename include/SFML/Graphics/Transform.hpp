@@ -30,7 +30,9 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -54,6 +56,10 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Construct a transform from a 3x3 matrix
     ///
+    /// Transforms are affine: only the first two rows are stored,
+    /// the last one is always (0, 0, 1) and the values passed
+    /// for it are ignored.
+    ///
     /// \param a00 Element (0, 0) of the matrix
     /// \param a01 Element (0, 1) of the matrix
     /// \param a02 Element (0, 2) of the matrix
@@ -69,6 +75,30 @@ public :
               float a10, float a11, float a12,
               float a20, float a21, float a22);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform(const Transform& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Transform();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform& operator =(const Transform& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the transform as a 4x4 matrix
     ///
@@ -81,11 +111,37 @@ public :
     /// glLoadMatrixf(transform.getMatrix());
     /// \endcode
     ///
+    /// The 4x4 matrix is not stored with the transform: it is
+    /// allocated the first time this function is called, and
+    /// updated at every call. The returned pointer remains valid
+    /// as long as the transform is alive, but its content is only
+    /// updated by the next call to getMatrix. This function can
+    /// be called from several threads on the same transform, but
+    /// it locks a mutex: prefer the other overload in code which
+    /// is called often.
+    ///
     /// \return Pointer to a 4x4 matrix
     ///
     ////////////////////////////////////////////////////////////
     const float* getMatrix() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the transform as a 4x4 matrix to an array
+    ///
+    /// This overload writes the same 16 floats as getMatrix(),
+    /// without any allocation.
+    ///
+    /// \code
+    /// float matrix[16];
+    /// transform.getMatrix(matrix);
+    /// glLoadMatrixf(matrix);
+    /// \endcode
+    ///
+    /// \param matrix Array of 16 floats which receives the 4x4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void getMatrix(float* matrix) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the inverse of the transform
     ///
@@ -118,6 +174,25 @@ public :
     ////////////////////////////////////////////////////////////
     Vector2f transformPoint(const Vector2f& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform the positions of an array of vertices
+    ///
+    /// This function is equivalent to calling transformPoint on
+    /// the position of each vertex, and copying the color and
+    /// texture coordinates unchanged, but it is much faster for
+    /// large arrays since it uses SIMD instructions when they
+    /// are available.
+    ///
+    /// \a vertices and \a result may point to the same array,
+    /// but the arrays must not partially overlap.
+    ///
+    /// \param vertices Vertices to transform
+    /// \param result   Array which receives the transformed vertices
+    /// \param count    Number of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vertex* vertices, Vertex* result, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
@@ -358,7 +433,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float m_matrix[16]; ///< 4x4 matrix defining the transformation
+    float          m_matrix[6]; ///< First two rows of the 3x3 matrix defining the transformation
+    mutable float* m_glMatrix;  ///< 4x4 matrix returned by getMatrix(), allocated on first use and protected by a mutex
 };
 
 ////////////////////////////////////////////////////////////
@@ -403,6 +479,8 @@ SFML_GRAPHICS_API Transform& operator *=(Transform& left, const Transform& right
 ////////////////////////////////////////////////////////////
 SFML_GRAPHICS_API Vector2f operator *(const Transform& left, const Vector2f& right);
 
+#include <SFML/Graphics/Transform.inl>
+
 } // namespace sf
 
 
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -44,6 +45,16 @@ class SFML_NETWORK_API SocketSelector
 {
 public :
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Ways of reporting sockets that are ready
+    ///
+    ////////////////////////////////////////////////////////////
+    enum TriggerMode
+    {
+        LevelTriggered, ///< A socket is reported as long as it has data to receive (default)
+        EdgeTriggered   ///< A socket is reported only when new data arrives
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -141,6 +152,65 @@ public :
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets found ready by the last call to wait
+    ///
+    /// Together with getReadySocket, this allows to visit only the
+    /// sockets that are ready instead of testing every socket
+    /// with isReady.
+    ///
+    /// \return Number of ready sockets
+    ///
+    /// \see getReadySocket
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadyCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the sockets found ready by the last call to wait
+    ///
+    /// If the socket was removed from the selector since the last
+    /// call to wait, a null pointer is returned, so that it is safe
+    /// to remove (and destroy) sockets while iterating.
+    ///
+    /// \param index Index of the ready socket, in range [0, getReadyCount() - 1]
+    ///
+    /// \return Pointer to the ready socket, or null if it was removed
+    ///
+    /// \see getReadyCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket* getReadySocket(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the way ready sockets are reported
+    ///
+    /// In edge-triggered mode, a socket is reported by wait only
+    /// when new data arrives, so it must be read until it returns
+    /// Socket::NotReady (it must be non-blocking) before the next
+    /// call to wait. This saves reporting the same sockets again and
+    /// again when you don't read all their data at once.
+    /// Edge-triggered mode is only available on Linux; on other
+    /// systems the selector stays level-triggered, which is
+    /// compatible with code written for the edge-triggered mode.
+    ///
+    /// \param mode New trigger mode
+    ///
+    /// \see getTriggerMode
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTriggerMode(TriggerMode mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the way ready sockets are reported
+    ///
+    /// \return Current trigger mode
+    ///
+    /// \see setTriggerMode
+    ///
+    ////////////////////////////////////////////////////////////
+    TriggerMode getTriggerMode() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -196,6 +266,20 @@ private :
 /// \li make it wait until there is data available on any of the sockets
 /// \li test each socket to find out which ones are ready
 ///
+/// On Linux the selector is based on epoll, so it is not limited
+/// in the number of sockets and the cost of wait doesn't depend on
+/// the number of sockets observed. When handling many sockets, iterate
+/// over the ready ones with getReadyCount and getReadySocket rather than
+/// calling isReady on every socket:
+/// \code
+/// for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+/// {
+///     sf::Socket* socket = selector.getReadySocket(i);
+///     if (socket)
+///         ...
+/// }
+/// \endcode
+///
 /// Usage example:
 /// \code
 /// // Create a socket to listen to new connections
@@ -141,6 +141,8 @@ public :
     ///
     /// In blocking mode, this function will wait until some
     /// bytes are actually received.
+    /// Bytes already read from the system by receive(Packet&)
+    /// but not part of a returned packet are returned first.
     /// This function will fail if the socket is not connected.
     ///
     /// \param data     Pointer to the array to fill with the received bytes
@@ -158,6 +160,8 @@ public :
     /// \brief Send a formatted packet of data to the remote peer
     ///
     /// This function will fail if the socket is not connected.
+    /// The packet is sent directly from its own buffer, its size
+    /// being gathered with its data into a single system call.
     ///
     /// \param packet Packet to send
     ///
@@ -168,11 +172,35 @@ public :
     ////////////////////////////////////////////////////////////
     Status send(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// This function will fail if the socket is not connected.
+    /// The packets are sent in order, and are gathered into as few
+    /// system calls as possible, which is much faster than sending
+    /// many small packets one by one. The receiver gets them as
+    /// regular packets, one per call to receive(Packet&).
+    ///
+    /// \param packets Array of packets to send
+    /// \param count   Number of packets in the array
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet* packets, std::size_t count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive a formatted packet of data from the remote peer
     ///
     /// In blocking mode, this function will wait until the whole packet
     /// has been received.
+    /// In non-blocking mode, all the data available in the system is
+    /// read at once and may contain several packets; the following ones
+    /// are returned by the next calls without reading the socket again.
+    /// So when the socket is reported ready by a selector, call this
+    /// function until it returns NotReady to get all the packets.
     /// This function will fail if the socket is not connected.
     ///
     /// \param packet Packet to fill with the received data
@@ -189,22 +217,22 @@ private:
     friend class TcpListener;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure holding the data of a pending packet
+    /// \brief Structure holding the bytes received but not consumed yet
     ///
     ////////////////////////////////////////////////////////////
-    struct PendingPacket
+    struct ReceiveBuffer
     {
-        PendingPacket();
+        ReceiveBuffer();
 
-        Uint32            Size;         ///< Data of packet size
-        std::size_t       SizeReceived; ///< Number of size bytes received so far
-        std::vector<char> Data;         ///< Data of the packet
+        std::vector<char> Data;  ///< Storage of the received bytes
+        std::size_t       Begin; ///< Offset of the first byte not consumed yet
+        std::size_t       End;   ///< Offset of the end of the received bytes
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    ReceiveBuffer m_receiveBuffer; ///< Bytes received from the system and not consumed yet
 };
 
 } // namespace sf
@@ -30,13 +30,13 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
 #include <vector>
 
 
 namespace sf
 {
-class IpAddress;
-class Packet;
 
 ////////////////////////////////////////////////////////////
 /// \brief Specialized socket using the UDP protocol
@@ -54,6 +54,17 @@ public :
         MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Packet exchanged with a remote peer, for batched send and receive
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Datagram
+    {
+        Packet         packet;        ///< Content of the datagram
+        IpAddress      remoteAddress; ///< Address of the receiver (send) or of the sender (receive)
+        unsigned short remotePort;    ///< Port of the receiver (send) or of the sender (receive)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -180,6 +191,48 @@ public :
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data, each to its own peer
+    ///
+    /// The datagrams are sent in order, with as few system calls
+    /// as possible (sendmmsg on Linux, one call per datagram on
+    /// other systems). Like with send(Packet&, ...), each packet
+    /// must not be greater than UdpSocket::MaxDatagramSize.
+    /// If the function doesn't return Done, \a sent tells how many
+    /// datagrams were sent before the error occured.
+    ///
+    /// \param datagrams Array of datagrams to send
+    /// \param count     Number of datagrams in the array
+    /// \param sent      This variable is filled with the number of datagrams actually sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several formatted packets of data at once
+    ///
+    /// The datagrams are read into the preallocated slots of the
+    /// \a datagrams array, with as few system calls as possible
+    /// (recvmmsg on Linux). In blocking mode, this function waits
+    /// until at least one datagram is received, then it takes all
+    /// the datagrams that are already queued, up to \a count.
+    /// It never waits for more datagrams once one was received.
+    ///
+    /// \param datagrams Array of datagrams to fill
+    /// \param count     Number of datagrams in the array
+    /// \param received  This variable is filled with the number of datagrams actually received
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Datagram* datagrams, std::size_t count, std::size_t& received);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -278,6 +331,21 @@ private:
 /// socket.send(message.c_str(), message.size() + 1, sender, port);
 /// \endcode
 ///
+/// When many datagrams are exchanged at each update, for
+/// example to replicate a game state to many clients, they
+/// can be sent and received in batches to save system calls:
+/// \code
+/// std::vector<sf::UdpSocket::Datagram> datagrams(clients.size());
+/// for (std::size_t i = 0; i < clients.size(); ++i)
+/// {
+///     datagrams[i].packet = state;
+///     datagrams[i].remoteAddress = clients[i].address;
+///     datagrams[i].remotePort = clients[i].port;
+/// }
+/// std::size_t sent = 0;
+/// socket.send(&datagrams[0], datagrams.size(), sent);
+/// \endcode
+///
 /// \see sf::Socket, sf::TcpSocket, sf::Packet
 ///
 ////////////////////////////////////////////////////////////
@@ -31,15 +31,22 @@
 
 #include <SFML/Config.hpp>
 #include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FramePacer.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/MpmcQueue.hpp>
 #include <SFML/System/Mutex.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/Semaphore.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/SpscQueue.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/ThreadLocal.hpp>
 #include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/ThreadPool.hpp>
 #include <SFML/System/Utf.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
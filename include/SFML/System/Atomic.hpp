@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ATOMIC_HPP
+#define SFML_ATOMIC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Minimal set of atomic operations on std::size_t, used by the
+// lock-free containers of the system module. They are
+// implemented with the compiler intrinsics, as C++98 doesn't
+// define atomics.
+////////////////////////////////////////////////////////////
+
+// Size of a cache line, used to keep data written by different threads apart
+const std::size_t cacheLineSize = 64;
+
+#if defined(_MSC_VER)
+
+////////////////////////////////////////////////////////////
+inline std::size_t atomicLoad(const volatile std::size_t& value)
+{
+    // Volatile reads have acquire semantics with Visual C++
+    std::size_t result = value;
+    _ReadWriteBarrier();
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+inline void atomicStore(volatile std::size_t& value, std::size_t desired)
+{
+    // Volatile writes have release semantics with Visual C++
+    _ReadWriteBarrier();
+    value = desired;
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool atomicCompareExchange(volatile std::size_t& value, std::size_t expected, std::size_t desired)
+{
+#if defined(_WIN64)
+    return _InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(&value), desired, expected) == static_cast<__int64>(expected);
+#else
+    return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(&value), desired, expected) == static_cast<long>(expected);
+#endif
+}
+
+#elif defined(__ATOMIC_ACQUIRE)
+
+////////////////////////////////////////////////////////////
+inline std::size_t atomicLoad(const volatile std::size_t& value)
+{
+    return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+}
+
+
+////////////////////////////////////////////////////////////
+inline void atomicStore(volatile std::size_t& value, std::size_t desired)
+{
+    __atomic_store_n(&value, desired, __ATOMIC_RELEASE);
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool atomicCompareExchange(volatile std::size_t& value, std::size_t expected, std::size_t desired)
+{
+    return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+inline std::size_t atomicLoad(const volatile std::size_t& value)
+{
+    // Older GCC versions only have full barriers
+    std::size_t result = value;
+    __sync_synchronize();
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+inline void atomicStore(volatile std::size_t& value, std::size_t desired)
+{
+    __sync_synchronize();
+    value = desired;
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool atomicCompareExchange(volatile std::size_t& value, std::size_t expected, std::size_t desired)
+{
+    return __sync_bool_compare_and_swap(&value, expected, desired);
+}
+
+#endif
+
+
+////////////////////////////////////////////////////////////
+inline std::size_t roundUpToPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 2;
+    while (result < value)
+        result *= 2;
+
+    return result;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ATOMIC_HPP
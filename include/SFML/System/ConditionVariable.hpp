@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONDITIONVARIABLE_HPP
+#define SFML_CONDITIONVARIABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ConditionVariableImpl;
+}
+
+class Mutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Blocks threads until another thread notifies them
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ConditionVariable : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition is notified
+    ///
+    /// The \a mutex must be locked once by the calling thread.
+    /// It is atomically unlocked while waiting, and locked
+    /// again before the function returns. The thread may wake
+    /// up without being notified, so the waited condition must
+    /// always be checked again in a loop.
+    ///
+    /// \param mutex Mutex protecting the waited condition
+    ///
+    /// \see notifyOne, notifyAll
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(Mutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition is notified, or a timeout expires
+    ///
+    /// Same as wait(Mutex&), but the waiting stops after \a timeout.
+    ///
+    /// \param mutex   Mutex protecting the waited condition
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    /// \see notifyOne, notifyAll
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Mutex& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one of the waiting threads, if any
+    ///
+    /// \see notifyAll, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the waiting threads
+    ///
+    /// \see notifyOne, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ConditionVariableImpl* m_conditionImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ConditionVariable
+/// \ingroup system
+///
+/// A condition variable lets threads sleep until another
+/// thread tells them that something happened, for example
+/// that new data is available. It is always used together
+/// with a sf::Mutex, which protects the data describing what
+/// happened; waiting unlocks the mutex, so that the other
+/// thread can modify the data and notify the condition.
+///
+/// Usage example:
+/// \code
+/// std::queue<Job> jobs;
+/// sf::Mutex mutex;
+/// sf::ConditionVariable condition;
+///
+/// void producer()
+/// {
+///     sf::Lock lock(mutex);
+///     jobs.push(Job());
+///     condition.notifyOne();
+/// }
+///
+/// void consumer()
+/// {
+///     sf::Lock lock(mutex);
+///     while (jobs.empty())
+///         condition.wait(mutex); // the mutex is unlocked while waiting
+///     Job job = jobs.front();
+///     jobs.pop();
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Semaphore
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEPACER_HPP
+#define SFML_FRAMEPACER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Utility class that keeps a loop running at a fixed rate
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FramePacer
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the duration of the recent frames
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Time         average;         ///< Average duration of the recent frames
+        Time         percentile99;    ///< Duration that 99% of the recent frames did not exceed
+        Time         maximum;         ///< Longest of the recent frames
+        unsigned int frameCount;      ///< Number of frames that the statistics were computed from
+        unsigned int missedDeadlines; ///< Number of frames already late when wait() was called, since the last reset
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The pacer starts with no frame time limit.
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the target duration of a frame
+    ///
+    /// \param frameTime Duration of a frame (use Time::Zero to disable the limit)
+    ///
+    /// \see getFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameTime(Time frameTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the target duration of a frame
+    ///
+    /// \return Duration of a frame, or Time::Zero if there's no limit
+    ///
+    /// \see setFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the margin which is spent spinning rather than sleeping
+    ///
+    /// The pacer sleeps until shortly before the deadline, then
+    /// yields and spins for the remaining time, because the OS
+    /// may oversleep by a millisecond or more. The margin actually
+    /// used grows automatically when sleeps are observed to
+    /// overshoot more than this minimum.
+    /// The default margin is 500 microseconds.
+    ///
+    /// \param margin Minimum time spent spinning before each deadline
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSpinMargin(Time margin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the end of the current frame
+    ///
+    /// This function must be called once per frame. Deadlines
+    /// are scheduled at regular intervals from the previous
+    /// ones rather than from the end of the wait, so that the
+    /// errors do not accumulate over time. If the caller falls
+    /// behind by more than a whole frame, the schedule restarts
+    /// from now instead of trying to catch up.
+    ///
+    /// Without a frame time limit, this function returns
+    /// immediately but still records the frame statistics.
+    ///
+    /// \return Duration of the frame that just ended
+    ///
+    ////////////////////////////////////////////////////////////
+    Time wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the schedule and clear the statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the recent frames
+    ///
+    /// The statistics cover the last frames only (up to a few
+    /// hundreds), so that they follow changes of the load.
+    ///
+    /// \return Statistics about the recent frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sleep, then spin until the given time
+    ///
+    /// \param deadline Time to wait for, relative to the pacer's clock
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitUntil(Time deadline);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Clock              m_clock;           ///< Clock which all the times are relative to
+    Time               m_frameTime;       ///< Target duration of a frame
+    Time               m_spinMargin;      ///< Minimum time spent spinning before a deadline
+    Time               m_sleepError;      ///< Estimate of how much the OS oversleeps
+    Time               m_deadline;        ///< End of the current frame
+    Time               m_frameStart;      ///< Start of the current frame
+    std::vector<Int64> m_history;         ///< Duration of the recent frames, in microseconds
+    std::size_t        m_historyIndex;    ///< Index of the next frame to record in m_history
+    unsigned int       m_missedDeadlines; ///< Number of missed deadlines since the last reset
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPACER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FramePacer
+/// \ingroup system
+///
+/// sf::FramePacer paces a loop (typically a game loop) at a
+/// fixed frequency. Plain sleeping is not precise enough for
+/// high refresh rates, as most OSes oversleep by up to a couple
+/// of milliseconds; sf::FramePacer sleeps for most of the
+/// remaining time and spins for the last part, so that frames
+/// end within a few microseconds of their deadline.
+///
+/// It also keeps statistics about the recent frames, which are
+/// useful to detect stutter.
+///
+/// sf::Window uses a sf::FramePacer internally to implement
+/// setFramerateLimit.
+///
+/// Usage example:
+/// \code
+/// sf::FramePacer pacer;
+/// pacer.setFrameTime(sf::microseconds(1000000 / 144));
+///
+/// while (running)
+/// {
+///     update();
+///     render();
+///     pacer.wait();
+/// }
+///
+/// sf::FramePacer::Statistics stats = pacer.getStatistics();
+/// std::cout << "p99: " << stats.percentile99.asMilliseconds() << " ms, "
+///           << "missed: " << stats.missedDeadlines << std::endl;
+/// \endcode
+///
+/// \see sf::Clock, sf::sleep
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MPMCQUEUE_HPP
+#define SFML_MPMCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue for any number of producer
+///        and consumer threads
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class MpmcQueue : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// The memory of all the elements is allocated once here.
+    ///
+    /// \param capacity Minimum number of elements that the queue can hold, rounded up to a power of two
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit MpmcQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push an element at the end of the queue
+    ///
+    /// \param value Element to push
+    ///
+    /// \return True if the element was pushed, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push several elements at the end of the queue
+    ///
+    /// All the free slots available at once are claimed with a
+    /// single atomic operation, and the pushed elements stay
+    /// contiguous in the queue.
+    ///
+    /// \param values Array of elements to push
+    /// \param count  Number of elements in the array
+    ///
+    /// \return Number of elements pushed, less than \a count if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const T* values, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop the element at the front of the queue
+    ///
+    /// \param value Variable to fill with the element
+    ///
+    /// \return True if an element was popped, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop several elements from the front of the queue
+    ///
+    /// \param values Array to fill with the elements
+    /// \param count  Maximum number of elements to pop
+    ///
+    /// \return Number of elements popped
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pop(T* values, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of elements of the queue
+    ///
+    /// \return Capacity of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of elements in the queue
+    ///
+    /// The result is only a snapshot, as other threads may
+    /// modify the queue at the same time.
+    ///
+    /// \return Number of elements in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Slot of the queue
+    ///
+    /// The sequence number tells whether the slot is ready to
+    /// be written or read for a given position in the queue.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Cell
+    {
+        volatile std::size_t sequence; ///< Position for which the slot is ready
+        T                    value;    ///< Element stored in the slot
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Claim consecutive slots at a position counter
+    ///
+    /// \param position Position counter to advance (enqueue or dequeue)
+    /// \param offset   Difference between the sequence of a ready slot and its position
+    /// \param count    Maximum number of slots to claim
+    /// \param first    Filled with the position of the first claimed slot
+    ///
+    /// \return Number of slots claimed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t claim(volatile std::size_t& position, std::size_t offset, std::size_t count, std::size_t& first);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Cell>    m_cells;                         ///< Ring buffer of slots
+    std::size_t          m_mask;                          ///< Capacity - 1, to wrap the positions
+    char                 m_padding1[priv::cacheLineSize]; ///< Keeps the positions away from the data above
+    volatile std::size_t m_enqueuePosition;               ///< Position of the next slot to write, shared by the producers
+    char                 m_padding2[priv::cacheLineSize]; ///< Keeps the producers and consumers positions on different cache lines
+    volatile std::size_t m_dequeuePosition;               ///< Position of the next slot to read, shared by the consumers
+    char                 m_padding3[priv::cacheLineSize]; ///< Keeps the consumers position away from the data that follows
+};
+
+#include <SFML/System/MpmcQueue.inl>
+
+} // namespace sf
+
+
+#endif // SFML_MPMCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MpmcQueue
+/// \ingroup system
+///
+/// sf::MpmcQueue is a fixed-size queue which any number of
+/// threads can push to and pop from at the same time, without
+/// any lock. Each slot carries a sequence number telling
+/// whether it is ready to be written or read, so that threads
+/// only compete for the position counters, which are kept on
+/// separate cache lines.
+///
+/// When the queue is full, push fails instead of waiting;
+/// likewise pop fails when the queue is empty. Combine it
+/// with a sf::Semaphore if threads must sleep until there's
+/// something to pop. The elements must be default-constructible
+/// and copyable.
+///
+/// Usage example:
+/// \code
+/// sf::MpmcQueue<Job*> jobs(1024);
+///
+/// // Any thread
+/// if (!jobs.push(new Job))
+///     ...; // the queue is full
+///
+/// // Any other thread
+/// Job* job;
+/// while (jobs.pop(job))
+///     job->run();
+/// \endcode
+///
+/// \see sf::SpscQueue
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity) :
+m_cells          (priv::roundUpToPowerOfTwo(capacity)),
+m_mask           (m_cells.size() - 1),
+m_enqueuePosition(0),
+m_dequeuePosition(0)
+{
+    // Every slot is initially ready to be written at its own position
+    for (std::size_t i = 0; i < m_cells.size(); ++i)
+        m_cells[i].sequence = i;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool MpmcQueue<T>::push(const T& value)
+{
+    return push(&value, 1) == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::push(const T* values, std::size_t count)
+{
+    // A slot can be written at position p when its sequence is p
+    std::size_t first = 0;
+    count = claim(m_enqueuePosition, 0, count, first);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Cell& cell = m_cells[(first + i) & m_mask];
+        cell.value = values[i];
+
+        // Make the slot readable
+        priv::atomicStore(cell.sequence, first + i + 1);
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool MpmcQueue<T>::pop(T& value)
+{
+    return pop(&value, 1) == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::pop(T* values, std::size_t count)
+{
+    // A slot can be read at position p when its sequence is p + 1
+    std::size_t first = 0;
+    count = claim(m_dequeuePosition, 1, count, first);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Cell& cell = m_cells[(first + i) & m_mask];
+        values[i] = cell.value;
+
+        // Make the slot writable again, for the next round of the ring buffer
+        priv::atomicStore(cell.sequence, first + i + m_mask + 1);
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::getCapacity() const
+{
+    return m_mask + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::getSize() const
+{
+    // Read the dequeue position first, so that the enqueue position is never behind it
+    std::size_t dequeuePosition = priv::atomicLoad(m_dequeuePosition);
+    std::size_t enqueuePosition = priv::atomicLoad(m_enqueuePosition);
+    return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::claim(volatile std::size_t& position, std::size_t offset, std::size_t count, std::size_t& first)
+{
+    std::size_t current = priv::atomicLoad(position);
+    while (count > 0)
+    {
+        std::size_t sequence = priv::atomicLoad(m_cells[current & m_mask].sequence);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - (current + offset));
+
+        // The slot is still used by the previous round: the queue is full (push) or empty (pop)
+        if (difference < 0)
+            return 0;
+
+        // Another thread has already claimed this slot, catch up
+        if (difference > 0)
+        {
+            current = priv::atomicLoad(position);
+            continue;
+        }
+
+        // The first slot is ready, see how many of the next ones are ready too
+        std::size_t claimed = 1;
+        while ((claimed < count) && (priv::atomicLoad(m_cells[(current + claimed) & m_mask].sequence) == current + claimed + offset))
+            claimed++;
+
+        // Take them all at once, unless another thread was faster
+        if (priv::atomicCompareExchange(position, current, current + claimed))
+        {
+            first = current;
+            return claimed;
+        }
+
+        current = priv::atomicLoad(position);
+    }
+
+    return 0;
+}
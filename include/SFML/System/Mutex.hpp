@@ -82,6 +82,8 @@ public :
 
 private :
 
+    friend class ConditionVariable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
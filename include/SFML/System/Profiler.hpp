@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PROFILER_HPP
+#define SFML_PROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+////////////////////////////////////////////////////////////
+/// \brief Profiling macros
+///
+/// SFML_PROFILE_ZONE(name) profiles the rest of the enclosing
+/// scope as a zone; \a name must be a string literal (or any
+/// string which outlives the profiler).
+/// SFML_PROFILE_THREAD(name) names the calling thread.
+///
+/// These macros expand to nothing unless SFML_ENABLE_PROFILER
+/// is defined, so that instrumented code has no overhead at
+/// all in regular builds.
+///
+////////////////////////////////////////////////////////////
+#ifdef SFML_ENABLE_PROFILER
+    #define SFML_PROFILE_CONCATENATE_(a, b) a##b
+    #define SFML_PROFILE_CONCATENATE(a, b) SFML_PROFILE_CONCATENATE_(a, b)
+    #define SFML_PROFILE_ZONE(name) sf::Profiler::Zone SFML_PROFILE_CONCATENATE(sfProfilerZone, __LINE__)(name)
+    #define SFML_PROFILE_THREAD(name) sf::Profiler::setThreadName(name)
+#else
+    #define SFML_PROFILE_ZONE(name)
+    #define SFML_PROFILE_THREAD(name)
+#endif
+
+
+namespace sf
+{
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Give access to the recording of profiling zones
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Profiler
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scoped profiling zone
+    ///
+    /// The zone starts when the instance is constructed and
+    /// ends when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Zone : NonCopyable
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Start the zone
+        ///
+        /// \param name Name of the zone; it is not copied and must remain valid
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Zone(const char* name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief End the zone and record it
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Zone();
+
+    private :
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        const char* m_name;  ///< Name of the zone, or null if the profiler was disabled when it started
+        Uint64      m_start; ///< Start time of the zone, in nanoseconds
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the recording of zones
+    ///
+    /// The profiler is disabled by default. While it is
+    /// disabled, zones cost a single test.
+    ///
+    /// \param enabled True to record the zones, false to ignore them
+    ///
+    /// \see isEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the recording of zones is enabled
+    ///
+    /// \return True if zones are recorded
+    ///
+    /// \see setEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the name of the calling thread in the traces
+    ///
+    /// Threads are numbered in the order in which they record
+    /// their first zone if they are not given a name. This
+    /// function doesn't allocate anything for the recording
+    /// of zones, so it can be called while the profiler is
+    /// disabled.
+    ///
+    /// \param name Name of the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadName(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the recorded zones to a Chrome trace file
+    ///
+    /// The file uses the JSON trace event format, which can be
+    /// opened in chrome://tracing or any compatible viewer.
+    /// The zones written to the file are removed from the
+    /// profiler, so this function can be called periodically
+    /// to write successive parts of a long session.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the file was successfully written
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool saveToFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of zones that were dropped
+    ///
+    /// Each thread records into a bounded buffer; when it is
+    /// full, new zones are dropped until the buffer is emptied
+    /// by saveToFile.
+    ///
+    /// \return Number of dropped zones since the program started
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getDroppedCount();
+
+private :
+
+    friend class Thread;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the resources of the calling thread
+    ///
+    /// This function is called by sf::Thread when its function
+    /// returns. The zones that the thread recorded are kept
+    /// until the next call to saveToFile, and its buffer is
+    /// reused by the threads that are started afterwards.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void releaseThread();
+};
+
+} // namespace sf
+
+
+#endif // SFML_PROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Profiler
+/// \ingroup system
+///
+/// sf::Profiler records named zones of code with nanosecond
+/// timestamps, and exports them as a Chrome trace file to
+/// see where the time goes in each thread.
+///
+/// Each thread records into its own lock-free buffer, so that
+/// threads never contend with each other, nor with the thread
+/// writing the trace. Recording a zone costs two reads of the
+/// clock and a few nanoseconds of bookkeeping.
+///
+/// Zones are normally declared with the SFML_PROFILE_ZONE
+/// macro, which expands to nothing unless SFML_ENABLE_PROFILER
+/// is defined. The hot paths of SFML itself are instrumented
+/// this way; they are recorded if SFML was built with the
+/// SFML_ENABLE_PROFILER CMake option.
+///
+/// Usage example:
+/// \code
+/// void update()
+/// {
+///     SFML_PROFILE_ZONE("update");
+///     ...
+/// }
+///
+/// sf::Profiler::setEnabled(true);
+/// for (int i = 0; i < 1000; ++i)
+/// {
+///     update();
+///     render();
+/// }
+/// sf::Profiler::saveToFile("trace.json");
+/// \endcode
+///
+////////////////////////////////////////////////////////////
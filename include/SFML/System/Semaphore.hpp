@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SEMAPHORE_HPP
+#define SFML_SEMAPHORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counter that threads can wait on until it is positive
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Semaphore : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial value of the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Semaphore(unsigned int count = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the counter, and wake up one waiting thread if any
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive, then decrement it
+    ///
+    /// \see post, tryWait
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive or a timeout expires
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the counter was decremented, false if the timeout expired
+    ///
+    /// \see post, tryWait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the counter if it is positive, without waiting
+    ///
+    /// \return True if the counter was decremented
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool tryWait();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SemaphoreImpl* m_semaphoreImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Semaphore
+/// \ingroup system
+///
+/// A semaphore is a counter shared between threads: post()
+/// increments it, and wait() blocks the calling thread until
+/// it is positive, then decrements it. A thread waiting on a
+/// semaphore doesn't use any CPU, and it wakes up as soon as
+/// another thread posts.
+///
+/// It is the simplest way of telling a thread that an event
+/// happened, such as "new data is ready" or "stop now",
+/// without polling. On Linux it is a single integer in user
+/// space, and the system is only involved when a thread
+/// actually has to sleep or be woken up.
+///
+/// Usage example:
+/// \code
+/// sf::Semaphore dataReady;
+///
+/// void producer()
+/// {
+///     writeData();
+///     dataReady.post();
+/// }
+///
+/// void consumer()
+/// {
+///     dataReady.wait(); // sleeps until the producer posts
+///     readData();
+/// }
+/// \endcode
+///
+/// \see sf::ConditionVariable, sf::Mutex
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPSCQUEUE_HPP
+#define SFML_SPSCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue for one producer thread
+///        and one consumer thread
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpscQueue : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// The memory of all the elements is allocated once here.
+    ///
+    /// \param capacity Minimum number of elements that the queue can hold, rounded up to a power of two
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpscQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push an element at the end of the queue
+    ///
+    /// This function must only be called by the producer thread.
+    ///
+    /// \param value Element to push
+    ///
+    /// \return True if the element was pushed, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push several elements at the end of the queue
+    ///
+    /// This function must only be called by the producer thread.
+    /// The elements are published all at once, which is cheaper
+    /// than pushing them one by one.
+    ///
+    /// \param values Array of elements to push
+    /// \param count  Number of elements in the array
+    ///
+    /// \return Number of elements pushed, less than \a count if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const T* values, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop the element at the front of the queue
+    ///
+    /// This function must only be called by the consumer thread.
+    ///
+    /// \param value Variable to fill with the element
+    ///
+    /// \return True if an element was popped, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop several elements from the front of the queue
+    ///
+    /// This function must only be called by the consumer thread.
+    ///
+    /// \param values Array to fill with the elements
+    /// \param count  Maximum number of elements to pop
+    ///
+    /// \return Number of elements popped
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pop(T* values, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of elements of the queue
+    ///
+    /// \return Capacity of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of elements in the queue
+    ///
+    /// The result is only a snapshot, as the other thread may
+    /// modify the queue at the same time.
+    ///
+    /// \return Number of elements in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T>       m_buffer;                         ///< Ring buffer of elements
+    std::size_t          m_mask;                           ///< Capacity - 1, to wrap the indices
+    char                 m_padding1[priv::cacheLineSize];  ///< Keeps the indices away from the data above
+    volatile std::size_t m_head;                           ///< Index of the next element to pop, written by the consumer
+    std::size_t          m_cachedTail;                     ///< Last value of m_tail seen by the consumer
+    char                 m_padding2[priv::cacheLineSize];  ///< Keeps the consumer and producer indices on different cache lines
+    volatile std::size_t m_tail;                           ///< Index of the next element to push, written by the producer
+    std::size_t          m_cachedHead;                     ///< Last value of m_head seen by the producer
+    char                 m_padding3[priv::cacheLineSize];  ///< Keeps the producer index away from the data that follows
+};
+
+#include <SFML/System/SpscQueue.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPSCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpscQueue
+/// \ingroup system
+///
+/// sf::SpscQueue is a fixed-size ring buffer which lets one
+/// thread hand data over to another thread without any lock:
+/// a thread never waits for the other one, which avoids the
+/// priority inversion problems of a mutex (for example an
+/// audio thread blocked by a lower-priority thread).
+///
+/// Each thread only writes its own index, and both indices
+/// live on different cache lines so that the threads don't
+/// slow each other down. Batched push and pop publish many
+/// elements with a single synchronization.
+///
+/// Only one thread may push, and only one thread may pop;
+/// use sf::MpmcQueue when there are more. The elements must
+/// be default-constructible and copyable.
+///
+/// Usage example:
+/// \code
+/// sf::SpscQueue<sf::Int16> samples(16384);
+///
+/// // Producer thread (e.g. decoding audio)
+/// std::size_t pushed = samples.push(&decoded[0], decoded.size());
+///
+/// // Consumer thread (e.g. feeding the audio device)
+/// sf::Int16 chunk[1024];
+/// std::size_t count = samples.pop(chunk, 1024);
+/// \endcode
+///
+/// \see sf::MpmcQueue
+///
+////////////////////////////////////////////////////////////
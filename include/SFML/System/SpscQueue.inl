@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity) :
+m_buffer    (priv::roundUpToPowerOfTwo(capacity)),
+m_mask      (m_buffer.size() - 1),
+m_head      (0),
+m_cachedTail(0),
+m_tail      (0),
+m_cachedHead(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscQueue<T>::push(const T& value)
+{
+    return push(&value, 1) == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::push(const T* values, std::size_t count)
+{
+    // Only look at the consumer index when the cached one says there's not enough room
+    std::size_t tail = m_tail;
+    std::size_t capacity = m_mask + 1;
+    if (capacity - (tail - m_cachedHead) < count)
+        m_cachedHead = priv::atomicLoad(m_head);
+
+    count = std::min(count, capacity - (tail - m_cachedHead));
+    for (std::size_t i = 0; i < count; ++i)
+        m_buffer[(tail + i) & m_mask] = values[i];
+
+    // Publish the new elements
+    if (count > 0)
+        priv::atomicStore(m_tail, tail + count);
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+    return pop(&value, 1) == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::pop(T* values, std::size_t count)
+{
+    // Only look at the producer index when the cached one says there are not enough elements
+    std::size_t head = m_head;
+    if (m_cachedTail - head < count)
+        m_cachedTail = priv::atomicLoad(m_tail);
+
+    count = std::min(count, m_cachedTail - head);
+    for (std::size_t i = 0; i < count; ++i)
+        values[i] = m_buffer[(head + i) & m_mask];
+
+    // Release the slots to the producer
+    if (count > 0)
+        priv::atomicStore(m_head, head + count);
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::getCapacity() const
+{
+    return m_mask + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::getSize() const
+{
+    // Read the head first, so that the tail is never behind it
+    std::size_t head = priv::atomicLoad(m_head);
+    return priv::atomicLoad(m_tail) - head;
+}
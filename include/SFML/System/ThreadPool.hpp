@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_THREADPOOL_HPP
+#define SFML_THREADPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct ThreadPoolTask;
+    struct ThreadPoolWorker;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of worker threads running tasks in parallel
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ThreadPool : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a task enqueued in a thread pool
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Task
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Constructs an empty handle, which refers to no task.
+        ///
+        ////////////////////////////////////////////////////////////
+        Task();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// \param copy Instance to copy
+        ///
+        ////////////////////////////////////////////////////////////
+        Task(const Task& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        /// Destroying the handle doesn't cancel the task.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Task();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Overload of assignment operator
+        ///
+        /// \param right Instance to assign
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        Task& operator =(const Task& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the task has finished running
+        ///
+        /// An empty handle is always finished.
+        ///
+        /// \return True if the task has finished
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isFinished() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Wait until the task has finished running
+        ///
+        /// While waiting, the calling thread runs other pending
+        /// tasks of the pool, so it is safe to wait for a task
+        /// from inside another task.
+        ///
+        ////////////////////////////////////////////////////////////
+        void wait();
+
+    private :
+
+        friend class ThreadPool;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle from a task
+        ///
+        /// \param task Shared state of the task
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Task(priv::ThreadPoolTask* task);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        priv::ThreadPoolTask* m_task; ///< Shared state of the task
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool and launch its workers
+    ///
+    /// \param workerCount Number of worker threads, or 0 for one per hardware thread
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ThreadPool(unsigned int workerCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// This destructor runs all the pending tasks, then
+    /// waits for the workers to finish.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ThreadPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of worker threads of the pool
+    ///
+    /// \return Number of workers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getWorkerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enqueue a functor with no argument
+    ///
+    /// The function is copied into the task, the same way as
+    /// with sf::Thread.
+    ///
+    /// \param function Functor or free function to run
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Task enqueue(F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enqueue a functor with an argument
+    ///
+    /// \param function Functor or free function to run
+    /// \param argument Argument to pass to the function
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F, typename A>
+    Task enqueue(F function, A argument);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enqueue a member function
+    ///
+    /// \param function Member function to run
+    /// \param object   Pointer to the object to call the function on
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename C>
+    Task enqueue(void(C::*function)(), C* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Call a function for every index of a range, in parallel
+    ///
+    /// The range is split into chunks of \a grainSize indices,
+    /// which are run by the workers and by the calling thread.
+    /// The function returns when the whole range was processed.
+    /// The \a function is called as function(index), and its
+    /// calls must be independent from each other.
+    ///
+    /// \param begin     First index of the range
+    /// \param end       One past the last index of the range
+    /// \param function  Functor or free function to call for each index
+    /// \param grainSize Number of indices per chunk, or 0 to choose automatically
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void parallelFor(std::size_t begin, std::size_t end, F function, std::size_t grainSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of hardware threads of the system
+    ///
+    /// \return Number of threads that can run concurrently (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getHardwareConcurrency();
+
+private :
+
+    friend class Task;
+    friend struct priv::ThreadPoolWorker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enqueue a task
+    ///
+    /// \param function Function to run, owned by the task
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    Task push(priv::ThreadFunc* function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a pending task and run it in the calling thread
+    ///
+    /// Workers take their own most recent task first, then they
+    /// steal the oldest tasks of the other workers.
+    ///
+    /// \param worker Worker running this function, or null for a foreign thread
+    ///
+    /// \return True if a task was run, false if there was none
+    ///
+    ////////////////////////////////////////////////////////////
+    bool runPendingTask(priv::ThreadPoolWorker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param worker Worker running this function
+    ///
+    ////////////////////////////////////////////////////////////
+    void work(priv::ThreadPoolWorker* worker);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<priv::ThreadPoolWorker*>   m_workers;         ///< Worker threads, each with its own queue of tasks
+    ThreadLocalPtr<priv::ThreadPoolWorker> m_currentWorker;   ///< Worker of the calling thread, null outside the pool
+    unsigned int                           m_nextWorker;      ///< Worker receiving the next task pushed by a foreign thread
+    unsigned int                           m_pushCount;       ///< Number of tasks pushed so far, to detect new tasks
+    unsigned int                           m_sleepingWorkers; ///< Number of workers waiting for a new task
+    bool                                   m_running;         ///< Cleared to stop the workers
+    Mutex                                  m_mutex;           ///< Mutex protecting the counters and m_running
+    ConditionVariable                      m_condition;       ///< Condition notified when a task is pushed or the pool is stopped
+};
+
+#include <SFML/System/ThreadPool.inl>
+
+} // namespace sf
+
+
+#endif // SFML_THREADPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ThreadPool
+/// \ingroup system
+///
+/// sf::ThreadPool runs tasks on a fixed set of worker threads,
+/// which avoids creating a thread for each job. Each worker
+/// has its own queue of tasks: tasks enqueued by a worker go
+/// to its own queue, and idle workers steal tasks from the
+/// queues of the busy ones, which keeps all of them busy with
+/// little contention.
+///
+/// Tasks are enqueued with the same kinds of functions as
+/// sf::Thread: functors, free functions with zero or one
+/// argument, and member functions. The returned sf::ThreadPool::Task
+/// can be used to wait until the task has finished.
+///
+/// parallelFor is a shortcut for the common case of running
+/// the same function on every element of an array.
+///
+/// Usage example:
+/// \code
+/// void loadTexture(const std::string* filename)
+/// {
+///     ...
+/// }
+///
+/// struct Brighten
+/// {
+///     void operator()(std::size_t index) const {pixels[index] = std::min(pixels[index] * 2, 255);}
+///     sf::Uint8* pixels;
+/// };
+///
+/// sf::ThreadPool pool; // one worker per hardware thread
+///
+/// // Load the files in the background
+/// std::vector<sf::ThreadPool::Task> tasks;
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     tasks.push_back(pool.enqueue(&loadTexture, &filenames[i]));
+///
+/// // Process an image with all the workers
+/// Brighten brighten = {pixels};
+/// pool.parallelFor(0, pixelCount, brighten);
+///
+/// // Wait for the files
+/// for (std::size_t i = 0; i < tasks.size(); ++i)
+///     tasks[i].wait();
+/// \endcode
+///
+/// \see sf::Thread
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+namespace priv
+{
+// Functor running a chunk of a parallelFor loop
+template <typename F>
+struct ParallelForChunk
+{
+    ParallelForChunk(F function, std::size_t begin, std::size_t end) : m_function(function), m_begin(begin), m_end(end) {}
+    void operator()() {for (std::size_t i = m_begin; i < m_end; ++i) m_function(i);}
+    F m_function;
+    std::size_t m_begin;
+    std::size_t m_end;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+ThreadPool::Task ThreadPool::enqueue(F function)
+{
+    return push(new priv::ThreadFunctor<F>(function));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F, typename A>
+ThreadPool::Task ThreadPool::enqueue(F function, A argument)
+{
+    return push(new priv::ThreadFunctorWithArg<F, A>(function, argument));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C>
+ThreadPool::Task ThreadPool::enqueue(void(C::*function)(), C* object)
+{
+    return push(new priv::ThreadMemberFunc<C>(function, object));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, F function, std::size_t grainSize)
+{
+    if (begin >= end)
+        return;
+
+    // By default, make a few chunks per worker so that they can balance the load
+    std::size_t count = end - begin;
+    if (grainSize == 0)
+    {
+        std::size_t chunks = (m_workers.size() + 1) * 4;
+        grainSize = (count + chunks - 1) / chunks;
+    }
+
+    // Enqueue all the chunks but the first one, which is run by the calling thread
+    std::size_t firstEnd = begin + std::min(grainSize, count);
+    std::vector<Task> tasks;
+    tasks.reserve((count - (firstEnd - begin)) / grainSize + 1);
+    for (std::size_t first = firstEnd; first < end; first += std::min(grainSize, end - first))
+    {
+        priv::ParallelForChunk<F> chunk(function, first, first + std::min(grainSize, end - first));
+        tasks.push_back(push(new priv::ThreadFunctor<priv::ParallelForChunk<F> >(chunk)));
+    }
+
+    priv::ParallelForChunk<F>(function, begin, firstEnd)();
+
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+        tasks[i].wait();
+}
@@ -34,7 +34,7 @@
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/WindowStyle.hpp>
 #include <SFML/Window/GlResource.hpp>
-#include <SFML/System/Clock.hpp>
+#include <SFML/System/FramePacer.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
@@ -358,17 +358,30 @@ public :
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// The delay is made of a sleep followed by a short busy-wait
+    /// (see sf::FramePacer), so that frames end within a few
+    /// microseconds of their deadline and late frames are
+    /// compensated by the following ones.
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
     ////////////////////////////////////////////////////////////
     void setFramerateLimit(unsigned int limit);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the duration of the recent frames
+    ///
+    /// The duration of a frame is the time between two calls
+    /// to display(). The statistics are available whether a
+    /// framerate limit is set or not.
+    ///
+    /// \return Statistics about the recent frames
+    ///
+    /// \see setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer::Statistics getFrameStatistics() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the joystick threshold
     ///
@@ -444,6 +457,16 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window's contents are displayed
+    ///
+    /// This function is called so that derived classes can
+    /// finish rendering the current frame before it is
+    /// shown on screen.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -471,8 +494,7 @@ private:
     ////////////////////////////////////////////////////////////
     priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
     priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
+    FramePacer        m_framePacer;     ///< Frame pacer implementing the framerate limit
     Vector2u          m_size;           ///< Current size of the window
 };
 
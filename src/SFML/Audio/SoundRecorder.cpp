@@ -28,7 +28,7 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <cstring>
 
@@ -117,8 +117,7 @@ bool SoundRecorder::start(unsigned int sampleRate)
 void SoundRecorder::stop()
 {
     // Stop the capturing thread
-    m_isCapturing = false;
-    m_thread.wait();
+    stopThread();
 
     // Notify derived class
     onStop();
@@ -170,8 +169,7 @@ bool SoundRecorder::setDevice(const std::string& name)
     if (m_isCapturing)
     {
         // Stop the capturing thread
-        m_isCapturing = false;
-        m_thread.wait();
+        stopThread();
 
         // Open the requested capture device for capturing 16 bits mono samples
         captureDevice = alcCaptureOpenDevice(name.c_str(), m_sampleRate, AL_FORMAT_MONO16, m_sampleRate);
@@ -241,8 +239,11 @@ void SoundRecorder::record()
         // Process available samples
         processCapturedSamples();
 
-        // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        // Don't bother the CPU while waiting for more captured data,
+        // but wake up as soon as the capture is stopped
+        Lock lock(m_threadMutex);
+        if (m_isCapturing)
+            m_threadCondition.wait(m_threadMutex, m_processingInterval);
     }
 
     // Capture is finished : clean up everything
@@ -273,6 +274,18 @@ void SoundRecorder::processCapturedSamples()
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::stopThread()
+{
+    {
+        Lock lock(m_threadMutex);
+        m_isCapturing = false;
+        m_threadCondition.notifyAll();
+    }
+    m_thread.wait();
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::cleanup()
 {
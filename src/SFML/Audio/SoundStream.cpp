@@ -28,8 +28,9 @@
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 
 #ifdef _MSC_VER
     #pragma warning(disable : 4355) // 'this' used in base member initializer list
@@ -116,8 +117,12 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Wait for the thread to terminate
-    m_isStreaming = false;
+    // Wake up the thread and wait for it to terminate
+    {
+        Lock lock(m_threadMutex);
+        m_isStreaming = false;
+        m_threadCondition.notifyAll();
+    }
     m_thread.wait();
 }
 
@@ -199,6 +204,8 @@ bool SoundStream::getLoop() const
 ////////////////////////////////////////////////////////////
 void SoundStream::streamData()
 {
+    SFML_PROFILE_THREAD("SoundStream");
+
     // Create the buffers
     alCheck(alGenBuffers(BufferCount, m_buffers));
     for (int i = 0; i < BufferCount; ++i)
@@ -269,9 +276,15 @@ void SoundStream::streamData()
             }
         }
 
-        // Leave some time for the other threads if the stream is still playing
+        // Leave some time for the other threads if the stream is still playing.
+        // OpenAL can't tell when a buffer is processed so we still check
+        // regularly, but stop() wakes us up immediately
         if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+        {
+            Lock lock(m_threadMutex);
+            if (m_isStreaming)
+                m_threadCondition.wait(m_threadMutex, milliseconds(10));
+        }
     }
 
     // Stop the playback
@@ -289,6 +302,8 @@ void SoundStream::streamData()
 ////////////////////////////////////////////////////////////
 bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
 {
+    SFML_PROFILE_ZONE("SoundStream::fillAndPushBuffer");
+
     bool requestStop = false;
 
     // Acquire audio data
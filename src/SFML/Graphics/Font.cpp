@@ -29,13 +29,17 @@
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/ThreadPool.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 
 
 namespace
@@ -57,6 +61,203 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Spread the bits of a key, so that consecutive keys don't fill consecutive slots
+    inline std::size_t hash(sf::Uint32 key)
+    {
+        sf::Uint32 mixed = key * 2654435761u;
+        return mixed ^ (mixed >> 16);
+    }
+    inline std::size_t hash(sf::Uint64 key)
+    {
+        const sf::Uint64 golden = (static_cast<sf::Uint64>(0x9E3779B9) << 32) | 0x7F4A7C15;
+        return static_cast<std::size_t>((key * golden) >> 32);
+    }
+
+    // Marks the pairs of the ASCII kerning table that were not looked up yet
+    const sf::Int16 unknownKerning = -32768;
+
+    // Identification of atlas cache files; the magic number also reveals files saved with another byte order
+    const sf::Uint32 atlasCacheMagic   = 0x43414653; // "SFAC"
+    const sf::Uint32 atlasCacheVersion = 1;
+
+    // Write a value to a binary stream, in the byte order of the machine
+    template <typename T>
+    void writeValue(std::ostream& stream, T value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // Read a value from a buffer, if it contains enough bytes
+    template <typename T>
+    bool readValue(const std::vector<char>& buffer, std::size_t& offset, T& value)
+    {
+        if (offset + sizeof(value) > buffer.size())
+            return false;
+
+        std::memcpy(&value, &buffer[offset], sizeof(value));
+        offset += sizeof(value);
+        return true;
+    }
+
+    // Add bytes to a 64-bit FNV-1a hash
+    void hashBytes(sf::Uint64& hash, const char* data, std::size_t size)
+    {
+        const sf::Uint64 prime = (static_cast<sf::Uint64>(0x100) << 32) | 0x1B3;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= prime;
+        }
+    }
+
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbours
+    const unsigned int padding = 1;
+
+    // Rasterize a glyph into an array of alpha values; its bounds (padding included) are left empty if it has no pixels
+    bool rasterizeGlyph(FT_Library library, FT_Face face, sf::Uint32 codePoint, bool bold, sf::Glyph& glyph, std::vector<sf::Uint8>& buffer)
+    {
+        // Load the glyph corresponding to the code point
+        if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+            return false;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return false;
+
+        // Apply bold if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (bold && outline)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_BitmapGlyph bitmapGlyph = (FT_BitmapGlyph)glyphDesc;
+        FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (bold && !outline)
+        {
+            FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+        }
+
+        // Compute the glyph's advance offset
+        glyph.advance = glyphDesc->advance.x >> 16;
+        if (bold)
+            glyph.advance += weight >> 6;
+
+        int width  = bitmap.width;
+        int height = bitmap.rows;
+        if ((width > 0) && (height > 0))
+        {
+            // Compute the glyph's bounding box
+            glyph.bounds.left   = bitmapGlyph->left - padding;
+            glyph.bounds.top    = -bitmapGlyph->top - padding;
+            glyph.bounds.width  = width + 2 * padding;
+            glyph.bounds.height = height + 2 * padding;
+
+            // Extract the glyph's pixels from the bitmap
+            buffer.resize(width * height);
+            const sf::Uint8* pixels = bitmap.buffer;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        buffer[x + y * width] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        buffer[x + y * width] = pixels[x];
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+
+        return true;
+    }
+
+    // Rasterizes a share of the glyphs requested by Font::preload, with its own FreeType face
+    struct GlyphRasterizer
+    {
+        void operator()(std::size_t chunk) const
+        {
+            // FreeType faces can't be used by several threads at once, and neither
+            // can libraries be used to create faces: each chunk opens its own
+            FT_Library library;
+            if (FT_Init_FreeType(&library) != 0)
+                return;
+
+            FT_Face face;
+            FT_Error error = fileName->empty() ?
+                FT_New_Memory_Face(library, static_cast<const FT_Byte*>(memoryData), static_cast<FT_Long>(memorySize), 0, &face) :
+                FT_New_Face(library, fileName->c_str(), 0, &face);
+
+            if (error == 0)
+            {
+                if ((FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0) && (FT_Set_Pixel_Sizes(face, 0, characterSize) == 0))
+                {
+                    for (std::size_t i = chunk; i < codePoints->size(); i += chunkCount)
+                        (*loaded)[i] = rasterizeGlyph(library, face, (*codePoints)[i], bold, (*glyphs)[i], (*bitmaps)[i]);
+                }
+
+                FT_Done_Face(face);
+            }
+
+            FT_Done_FreeType(library);
+        }
+
+        const std::string*                  fileName;      // File to open the face from, or empty
+        const void*                         memoryData;    // Memory to open the face from, if there's no file
+        std::size_t                         memorySize;    // Size of the memory to open the face from
+        unsigned int                        characterSize; // Character size of the glyphs
+        bool                                bold;          // Rasterize the bold version of the glyphs?
+        std::size_t                         chunkCount;    // Number of chunks, each one handles every chunkCount-th glyph
+        const std::vector<sf::Uint32>*      codePoints;    // Code points to rasterize
+        std::vector<sf::Glyph>*             glyphs;        // Receives the metrics of the glyphs
+        std::vector<std::vector<sf::Uint8> >* bitmaps;     // Receives the alpha values of the glyphs
+        std::vector<char>*                  loaded;        // Receives whether each glyph could be rasterized
+    };
+
+    // Create the alpha values of an empty glyph texture, with a 2x2 opaque square for texturing underlines
+    void createPagePixels(std::vector<sf::Uint8>& pixels, unsigned int width, unsigned int height)
+    {
+        pixels.assign(width * height, 0);
+        for (unsigned int x = 0; x < 2; ++x)
+            for (unsigned int y = 0; y < 2; ++y)
+                pixels[x + y * width] = 255;
+    }
+
+    // Copy a rectangle of alpha values from a buffer to another one
+    void copyPixels(const std::vector<sf::Uint8>& source, unsigned int sourceWidth, const sf::IntRect& sourceRect,
+                    std::vector<sf::Uint8>& destination, unsigned int destinationWidth, unsigned int x, unsigned int y)
+    {
+        for (int row = 0; row < sourceRect.height; ++row)
+        {
+            const sf::Uint8* begin = &source[sourceRect.left + (sourceRect.top + row) * sourceWidth];
+            std::copy(begin, begin + sourceRect.width, &destination[x + (y + row) * destinationWidth]);
+        }
+    }
 }
 
 
@@ -68,7 +269,12 @@ m_library  (NULL),
 m_face     (NULL),
 m_streamRec(NULL),
 m_refCount (NULL),
-m_info	   ()
+m_info	   (),
+m_memoryData  (NULL),
+m_memorySize  (0),
+m_atlasBudget (0),
+m_unusedFrames(0),
+m_frame       (0)
 {
 
 }
@@ -81,14 +287,25 @@ m_face       (copy.m_face),
 m_streamRec  (copy.m_streamRec),
 m_refCount   (copy.m_refCount),
 m_info		 (copy.m_info),
+m_fileName   (copy.m_fileName),
+m_memoryData (copy.m_memoryData),
+m_memorySize (copy.m_memorySize),
 m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_pageLookup (),
+m_pixelBuffer(copy.m_pixelBuffer),
+m_atlasBudget (copy.m_atlasBudget),
+m_unusedFrames(copy.m_unusedFrames),
+m_frame       (copy.m_frame)
 {
     // Note: as FreeType doesn't provide functions for copying/cloning,
     // we must share all the FreeType pointers
 
     if (m_refCount)
         (*m_refCount)++;
+
+    // The lookup table must point to our own pages
+    for (PageTable::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        m_pageLookup.insert(it->first, &it->second);
 }
 
 
@@ -134,6 +351,7 @@ bool Font::loadFromFile(const std::string& filename)
 
     // Store the loaded font in our ugly void* :)
     m_face = face;
+    m_fileName = filename;
 
 	// Store the font information
 	m_info.family = face->family_name ? face->family_name : std::string();
@@ -177,6 +395,8 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
 
     // Store the loaded font in our ugly void* :)
     m_face = face;
+    m_memoryData = data;
+    m_memorySize = sizeInBytes;
 
 	// Store the font information
 	m_info.family = face->family_name ? face->family_name : std::string();
@@ -259,24 +479,460 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
-
-    // Build the key by combining the code point and the bold flag
-    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
+    Page& page = getPage(characterSize);
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    Uint32* index = findGlyphIndex(page, codePoint, bold);
+
+    // Found: just return it, after loading it again if it was evicted from the texture
+    if (*index)
     {
-        // Found: just return it
-        return it->second;
+        CachedGlyph& cached = page.glyphs[*index - 1];
+        cached.lastUse = m_frame;
+        if (!cached.resident)
+        {
+            cached.glyph = loadGlyph(codePoint, characterSize, bold);
+            cached.resident = true;
+        }
+
+        return cached.glyph;
     }
-    else
+
+    // Not found: we have to load it
+    page.glyphs.push_back(CachedGlyph(loadGlyph(codePoint, characterSize, bold), m_frame));
+    *index = static_cast<Uint32>(page.glyphs.size());
+
+    return page.glyphs.back().glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preload(const std::vector<Range>& ranges, unsigned int characterSize, bool bold) const
+{
+    SFML_PROFILE_ZONE("Font::preload");
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return;
+
+    Page& page = getPage(characterSize);
+
+    // Gather the code points whose glyph is not in the texture yet
+    std::vector<Uint32> codePoints;
+    for (std::vector<Range>::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+    {
+        for (Uint32 codePoint = it->first; codePoint <= it->last; ++codePoint)
+        {
+            Uint32 index = *findGlyphIndex(page, codePoint, bold);
+            if (!index || !page.glyphs[index - 1].resident)
+                codePoints.push_back(codePoint);
+
+            if (codePoint == it->last)
+                break;
+        }
+    }
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+    if (codePoints.empty())
+        return;
+
+    // Rasterize the glyphs
+    std::vector<Glyph> glyphs(codePoints.size());
+    std::vector<std::vector<Uint8> > bitmaps(codePoints.size());
+    std::vector<char> loaded(codePoints.size(), 0);
+    if (!m_fileName.empty() || m_memoryData)
+    {
+        // Use all the hardware threads, each one with its own face
+        ThreadPool pool;
+
+        GlyphRasterizer rasterizer;
+        rasterizer.fileName      = &m_fileName;
+        rasterizer.memoryData    = m_memoryData;
+        rasterizer.memorySize    = m_memorySize;
+        rasterizer.characterSize = characterSize;
+        rasterizer.bold          = bold;
+        rasterizer.chunkCount    = std::min<std::size_t>(pool.getWorkerCount() + 1, codePoints.size());
+        rasterizer.codePoints    = &codePoints;
+        rasterizer.glyphs        = &glyphs;
+        rasterizer.bitmaps       = &bitmaps;
+        rasterizer.loaded        = &loaded;
+        pool.parallelFor(0, rasterizer.chunkCount, rasterizer, 1);
+    }
+    else if (setCurrentSize(characterSize))
+    {
+        // The font was loaded from a stream, which can't be shared: use our own face
+        for (std::size_t i = 0; i < codePoints.size(); ++i)
+            loaded[i] = rasterizeGlyph(static_cast<FT_Library>(m_library), face, codePoints[i], bold, glyphs[i], bitmaps[i]);
+    }
+
+    // Place the glyphs in the texture and store them in the cache; they are not used by
+    // any geometry yet, so they are stamped with the previous frame, which lets the font
+    // move or evict them when it makes room for the glyphs of the current frame
+    const std::size_t noSlot = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> slots(codePoints.size(), noSlot);
+    for (std::size_t i = 0; i < codePoints.size(); ++i)
+    {
+        // Glyphs that failed will be tried again when they are requested
+        if (!loaded[i])
+            continue;
+
+        if (glyphs[i].bounds.width > 0)
+            glyphs[i].textureRect = findGlyphRect(page, glyphs[i].bounds.width, glyphs[i].bounds.height);
+
+        Uint32* index = findGlyphIndex(page, codePoints[i], bold);
+        if (*index)
+        {
+            CachedGlyph& cached = page.glyphs[*index - 1];
+            cached.glyph = glyphs[i];
+            cached.lastUse = m_frame - 1;
+            cached.resident = true;
+        }
+        else
+        {
+            page.glyphs.push_back(CachedGlyph(glyphs[i], m_frame - 1));
+            *index = static_cast<Uint32>(page.glyphs.size());
+        }
+        slots[i] = *index - 1;
+    }
+
+    // Find the area of the texture covered by the new glyphs; their final position
+    // is read from the cache, since evictions may have moved the first ones
+    Vector2u size = page.texture.getSize();
+    int left   = size.x;
+    int top    = size.y;
+    int right  = 0;
+    int bottom = 0;
+    for (std::size_t i = 0; i < codePoints.size(); ++i)
+    {
+        if ((slots[i] == noSlot) || !page.glyphs[slots[i]].resident)
+            continue;
+
+        const IntRect& rect = page.glyphs[slots[i]].glyph.textureRect;
+        if (rect.width <= static_cast<int>(2 * padding))
+            continue;
+
+        left   = std::min(left, rect.left);
+        top    = std::min(top, rect.top);
+        right  = std::max(right, rect.left + rect.width);
+        bottom = std::max(bottom, rect.top + rect.height);
+    }
+    if ((right <= left) || (bottom <= top))
+        return;
+    IntRect area(left, top, right - left, bottom - top);
+
+    // Write all the new glyphs over the current pixels, and upload them at once
+    std::vector<Uint8> pixels(size.x * size.y);
+    page.texture.copyAlpha(&pixels[0]);
+    for (std::size_t i = 0; i < codePoints.size(); ++i)
+    {
+        if ((slots[i] == noSlot) || !page.glyphs[slots[i]].resident)
+            continue;
+
+        const IntRect& rect = page.glyphs[slots[i]].glyph.textureRect;
+        if (rect.width <= static_cast<int>(2 * padding))
+            continue;
+
+        IntRect source(0, 0, rect.width - 2 * padding, rect.height - 2 * padding);
+        copyPixels(bitmaps[i], glyphs[i].bounds.width - 2 * padding, source, pixels, size.x, rect.left + padding, rect.top + padding);
+    }
+
+    std::vector<Uint8> region(area.width * area.height);
+    copyPixels(pixels, size.x, area, region, area.width, 0, 0);
+    page.texture.updateAlpha(&region[0], area.width, area.height, area.left, area.top);
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::saveAtlasCache(const std::string& filename) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        err() << "Failed to save font atlas cache \"" << filename << "\" (no font is loaded)" << std::endl;
+        return false;
     }
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to save font atlas cache \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+
+    // Header
+    writeValue(file, atlasCacheMagic);
+    writeValue(file, atlasCacheVersion);
+    writeValue(file, computeFontHash());
+    writeValue(file, static_cast<Uint32>(m_pages.size()));
+
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        const Page& page = it->second;
+
+        // Gather the glyphs stored in the texture, keyed like in the index tables
+        std::vector<std::pair<Uint32, const Glyph*> > glyphs;
+        for (Uint32 bold = 0; bold < 2; ++bold)
+        {
+            for (Uint32 codePoint = 0; codePoint < 256; ++codePoint)
+            {
+                Uint32 index = page.latin[bold][codePoint];
+                if (index && page.glyphs[index - 1].resident)
+                    glyphs.push_back(std::make_pair((bold << 31) | codePoint, &page.glyphs[index - 1].glyph));
+            }
+        }
+        for (std::size_t i = 0; i < page.table.entries.size(); ++i)
+        {
+            const GlyphTable::Entry& entry = page.table.entries[i];
+            if (entry.used && entry.value && page.glyphs[entry.value - 1].resident)
+                glyphs.push_back(std::make_pair(entry.key, &page.glyphs[entry.value - 1].glyph));
+        }
+
+        // Compute the kerning of every pair of their characters
+        std::vector<Uint32> codePoints;
+        for (std::size_t i = 0; i < glyphs.size(); ++i)
+            codePoints.push_back(glyphs[i].first & 0x7FFFFFFF);
+        std::sort(codePoints.begin(), codePoints.end());
+        codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+
+        std::vector<std::pair<Uint64, int> > kerning;
+        if (FT_HAS_KERNING(face) && setCurrentSize(it->first))
+        {
+            std::vector<FT_UInt> indices(codePoints.size());
+            for (std::size_t i = 0; i < codePoints.size(); ++i)
+                indices[i] = FT_Get_Char_Index(face, codePoints[i]);
+
+            for (std::size_t i = 0; i < codePoints.size(); ++i)
+            {
+                for (std::size_t j = 0; j < codePoints.size(); ++j)
+                {
+                    FT_Vector offset;
+                    FT_Get_Kerning(face, indices[i], indices[j], FT_KERNING_DEFAULT, &offset);
+                    if (offset.x >> 6)
+                        kerning.push_back(std::make_pair((static_cast<Uint64>(codePoints[i]) << 32) | codePoints[j], static_cast<int>(offset.x >> 6)));
+                }
+            }
+        }
+
+        // Page header
+        Vector2u size = page.texture.getSize();
+        writeValue(file, static_cast<Uint32>(it->first));
+        writeValue(file, static_cast<Uint32>(size.x));
+        writeValue(file, static_cast<Uint32>(size.y));
+        writeValue(file, static_cast<Uint32>(glyphs.size()));
+        writeValue(file, static_cast<Uint32>(kerning.size()));
+
+        // Glyphs
+        for (std::size_t i = 0; i < glyphs.size(); ++i)
+        {
+            const Glyph& glyph = *glyphs[i].second;
+            writeValue(file, glyphs[i].first);
+            writeValue(file, static_cast<Int32>(glyph.advance));
+            writeValue(file, static_cast<Int32>(glyph.bounds.left));
+            writeValue(file, static_cast<Int32>(glyph.bounds.top));
+            writeValue(file, static_cast<Int32>(glyph.bounds.width));
+            writeValue(file, static_cast<Int32>(glyph.bounds.height));
+            writeValue(file, static_cast<Int32>(glyph.textureRect.left));
+            writeValue(file, static_cast<Int32>(glyph.textureRect.top));
+            writeValue(file, static_cast<Int32>(glyph.textureRect.width));
+            writeValue(file, static_cast<Int32>(glyph.textureRect.height));
+        }
+
+        // Kerning pairs
+        for (std::size_t i = 0; i < kerning.size(); ++i)
+        {
+            writeValue(file, kerning[i].first);
+            writeValue(file, static_cast<Int32>(kerning[i].second));
+        }
+
+        // Pixels (alpha only)
+        std::vector<Uint8> pixels(size.x * size.y);
+        page.texture.copyAlpha(&pixels[0]);
+        file.write(reinterpret_cast<const char*>(&pixels[0]), pixels.size());
+    }
+
+    if (!file)
+    {
+        err() << "Failed to save font atlas cache \"" << filename << "\" (failed to write the file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadAtlasCache(const std::string& filename)
+{
+    if (!m_face)
+    {
+        err() << "Failed to load font atlas cache \"" << filename << "\" (no font is loaded)" << std::endl;
+        return false;
+    }
+
+    // Read the whole file at once
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to load font atlas cache \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+    file.seekg(0, std::ios_base::end);
+    std::vector<char> buffer(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0, std::ios_base::beg);
+    if (!buffer.empty())
+        file.read(&buffer[0], buffer.size());
+
+    // Check the header
+    std::size_t offset = 0;
+    Uint32 magic = 0;
+    Uint32 version = 0;
+    Uint64 hash = 0;
+    Uint32 pageCount = 0;
+    if (!readValue(buffer, offset, magic) || (magic != atlasCacheMagic) ||
+        !readValue(buffer, offset, version) || (version != atlasCacheVersion))
+    {
+        err() << "Failed to load font atlas cache \"" << filename << "\" (unsupported format, version or byte order)" << std::endl;
+        return false;
+    }
+    if (!readValue(buffer, offset, hash) || (hash != computeFontHash()))
+    {
+        err() << "Failed to load font atlas cache \"" << filename << "\" (it was saved for another font)" << std::endl;
+        return false;
+    }
+    // Make sure that the file contains all the pages before touching the current ones;
+    // each size is checked against the remaining bytes separately, so that nothing can overflow
+    const std::size_t glyphSize = sizeof(Uint32) + 9 * sizeof(Int32);
+    const std::size_t kerningSize = sizeof(Uint64) + sizeof(Int32);
+    const std::size_t pagesOffset = offset;
+    bool valid = readValue(buffer, offset, pageCount);
+    for (Uint32 i = 0; valid && (i < pageCount); ++i)
+    {
+        Uint32 characterSize = 0;
+        Uint32 width = 0;
+        Uint32 height = 0;
+        Uint32 glyphCount = 0;
+        Uint32 kerningCount = 0;
+        valid = readValue(buffer, offset, characterSize) &&
+                readValue(buffer, offset, width) &&
+                readValue(buffer, offset, height) &&
+                readValue(buffer, offset, glyphCount) &&
+                readValue(buffer, offset, kerningCount) &&
+                (width >= 3) && (height >= 3) && (width <= Texture::getMaximumSize()) && (height <= Texture::getMaximumSize()) &&
+                (glyphCount <= (buffer.size() - offset) / glyphSize);
+        if (!valid)
+            break;
+        offset += glyphCount * glyphSize;
+
+        valid = (kerningCount <= (buffer.size() - offset) / kerningSize);
+        if (!valid)
+            break;
+        offset += kerningCount * kerningSize;
+
+        valid = (height <= (buffer.size() - offset) / width);
+        if (!valid)
+            break;
+        offset += static_cast<std::size_t>(width) * height;
+    }
+    if (!valid)
+    {
+        err() << "Failed to load font atlas cache \"" << filename << "\" (the file is corrupted)" << std::endl;
+        return false;
+    }
+
+    // Now that the file is known to be complete, read the pages again and load them
+    offset = pagesOffset;
+    readValue(buffer, offset, pageCount);
+    for (Uint32 i = 0; i < pageCount; ++i)
+    {
+        Uint32 characterSize = 0;
+        Uint32 width = 0;
+        Uint32 height = 0;
+        Uint32 glyphCount = 0;
+        Uint32 kerningCount = 0;
+        readValue(buffer, offset, characterSize);
+        readValue(buffer, offset, width);
+        readValue(buffer, offset, height);
+        readValue(buffer, offset, glyphCount);
+        readValue(buffer, offset, kerningCount);
+
+        // Start from an empty page
+        Page& page = getPage(characterSize);
+        page.glyphs.clear();
+        std::memset(page.latin, 0, sizeof(page.latin));
+        page.table.clear();
+        page.asciiKerning.clear();
+        page.kerning.clear();
+        page.kerningChars.clear();
+        std::vector<Uint32> asciiChars;
+
+        // Glyphs
+        for (Uint32 j = 0; j < glyphCount; ++j)
+        {
+            Uint32 key = 0;
+            Int32 values[9];
+            readValue(buffer, offset, key);
+            for (int k = 0; k < 9; ++k)
+                readValue(buffer, offset, values[k]);
+
+            Glyph glyph;
+            glyph.advance     = values[0];
+            glyph.bounds      = IntRect(values[1], values[2], values[3], values[4]);
+            glyph.textureRect = IntRect(values[5], values[6], values[7], values[8]);
+
+            // Rectangles outside the texture would break the packing of the next glyphs
+            const IntRect& rect = glyph.textureRect;
+            if ((rect.left < 0) || (rect.top < 0) || (rect.width < 0) || (rect.height < 0) ||
+                (rect.width > static_cast<int>(width) - rect.left) || (rect.height > static_cast<int>(height) - rect.top))
+                continue;
+
+            Uint32 codePoint = key & 0x7FFFFFFF;
+            page.glyphs.push_back(CachedGlyph(glyph, m_frame));
+            *findGlyphIndex(page, codePoint, (key >> 31) != 0) = static_cast<Uint32>(page.glyphs.size());
+            if ((codePoint < 128) && !page.kerningChars.find(codePoint))
+                asciiChars.push_back(codePoint);
+            page.kerningChars.insert(codePoint, 0);
+        }
+
+        // Kerning pairs; the pairs of ASCII characters missing from the file have no kerning
+        page.asciiKerning.resize(128 * 128, unknownKerning);
+        for (std::size_t j = 0; j < asciiChars.size(); ++j)
+        {
+            for (std::size_t k = 0; k < asciiChars.size(); ++k)
+                page.asciiKerning[asciiChars[j] * 128 + asciiChars[k]] = 0;
+        }
+        for (Uint32 j = 0; j < kerningCount; ++j)
+        {
+            Uint64 pair = 0;
+            Int32 value = 0;
+            readValue(buffer, offset, pair);
+            readValue(buffer, offset, value);
+
+            Uint32 first = static_cast<Uint32>(pair >> 32);
+            Uint32 second = static_cast<Uint32>(pair);
+            if ((first < 128) && (second < 128))
+                page.asciiKerning[first * 128 + second] = static_cast<Int16>(value);
+            else
+                page.kerning.insert(pair, value);
+        }
+
+        // Pixels
+        page.texture.create(width, height, true);
+        page.texture.updateAlpha(reinterpret_cast<const Uint8*>(&buffer[offset]), width, height, 0, 0);
+        offset += static_cast<std::size_t>(width) * height;
+
+        page.rebuildSkyline();
+        page.revision++;
+    }
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
 }
 
 
@@ -287,26 +943,44 @@ int Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) co
     if (first == 0 || second == 0)
         return 0;
 
+    // Invalid font, or no kerning
     FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || !FT_HAS_KERNING(face))
+        return 0;
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    // The kerning is cached along with the glyphs of the character size, if they are already loaded
+    Page** page = m_pageLookup.find(characterSize);
+    if (!page)
+        return loadKerning(first, second, characterSize);
+
+    // Pairs of ASCII characters are directly indexed
+    if ((first < 128) && (second < 128))
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        std::vector<Int16>& asciiKerning = (*page)->asciiKerning;
+        if (asciiKerning.empty())
+            asciiKerning.resize(128 * 128, unknownKerning);
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+        Int16& kerning = asciiKerning[first * 128 + second];
+        if (kerning == unknownKerning)
+            kerning = static_cast<Int16>(loadKerning(first, second, characterSize));
 
-        // Return the X advance
-        return kerning.x >> 6;
+        return kerning;
     }
-    else
-    {
-        // Invalid font, or no kerning
+
+    // The other pairs are stored in a hash table
+    Uint64 key = (static_cast<Uint64>(first) << 32) | second;
+    int* kerning = (*page)->kerning.find(key);
+    if (kerning)
+        return *kerning;
+
+    // Pairs of characters loaded from a cache file, but missing from it, have no kerning
+    if ((*page)->kerningChars.find(first) && (*page)->kerningChars.find(second))
         return 0;
-    }
+
+    int loaded = loadKerning(first, second, characterSize);
+    (*page)->kerning.insert(key, loaded);
+
+    return loaded;
 }
 
 
@@ -329,7 +1003,51 @@ int Font::getLineSpacing(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    return getPage(characterSize).texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setAtlasBudget(unsigned int maxTextureSize, unsigned int unusedFrames)
+{
+    m_atlasBudget = maxTextureSize;
+    m_unusedFrames = unusedFrames;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::advanceFrame()
+{
+    m_frame++;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::AtlasStatistics Font::getAtlasStatistics(unsigned int characterSize) const
+{
+    const Page& page = getPage(characterSize);
+
+    AtlasStatistics statistics;
+    statistics.textureSize = page.texture.getSize();
+    statistics.glyphCount  = 0;
+    statistics.occupancy   = static_cast<float>(page.usedArea) / (statistics.textureSize.x * statistics.textureSize.y);
+    statistics.evictions   = page.evictions;
+    statistics.repacks     = page.repacks;
+
+    for (std::deque<CachedGlyph>::const_iterator it = page.glyphs.begin(); it != page.glyphs.end(); ++it)
+    {
+        if (it->resident && (it->glyph.textureRect.width > 0))
+            statistics.glyphCount++;
+    }
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getAtlasRevision(unsigned int characterSize) const
+{
+    return getPage(characterSize).revision;
 }
 
 
@@ -340,9 +1058,16 @@ Font& Font::operator =(const Font& right)
 
     std::swap(m_library,     temp.m_library);
     std::swap(m_face,        temp.m_face);
+    std::swap(m_fileName,    temp.m_fileName);
+    std::swap(m_memoryData,  temp.m_memoryData);
+    std::swap(m_memorySize,  temp.m_memorySize);
     std::swap(m_pages,       temp.m_pages);
+    std::swap(m_pageLookup,  temp.m_pageLookup);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
     std::swap(m_refCount,    temp.m_refCount);
+    std::swap(m_atlasBudget, temp.m_atlasBudget);
+    std::swap(m_unusedFrames,temp.m_unusedFrames);
+    std::swap(m_frame,       temp.m_frame);
 
     return *this;
 }
@@ -382,14 +1107,56 @@ void Font::cleanup()
     m_face      = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
+    m_fileName.clear();
+    m_memoryData = NULL;
+    m_memorySize = 0;
     m_pages.clear();
+    m_pageLookup.clear();
     m_pixelBuffer.clear();
 }
 
 
+////////////////////////////////////////////////////////////
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    // Most texts use a single size, so the lookup is usually resolved at the first probe
+    Page** page = m_pageLookup.find(characterSize);
+    if (page)
+        return **page;
+
+    // Elements of a std::map are never moved, so the lookup table can point to them
+    Page& created = m_pages[characterSize];
+    m_pageLookup.insert(characterSize, &created);
+
+    return created;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32* Font::findGlyphIndex(Page& page, Uint32 codePoint, bool bold) const
+{
+    // The first 256 code points are directly indexed, the
+    // other ones are found by combining the code point and the bold flag
+    if (codePoint < 256)
+        return &page.latin[bold ? 1 : 0][codePoint];
+
+    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
+    Uint32* index = page.table.find(key);
+    if (!index)
+    {
+        page.table.insert(key, 0);
+        index = page.table.find(key);
+    }
+
+    return index;
+}
+
+
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
+    SFML_PROFILE_ZONE("Font::loadGlyph");
+
     // The glyph to return
     Glyph glyph;
 
@@ -402,177 +1169,222 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+    // Rasterize the glyph
+    if (!rasterizeGlyph(static_cast<FT_Library>(m_library), face, codePoint, bold, glyph, m_pixelBuffer))
         return glyph;
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
-
-    // Apply bold if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (bold && outline)
+    if (glyph.bounds.width > 0)
     {
-        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-        FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        // Get the glyphs page corresponding to the character size
+        Page& page = getPage(characterSize);
+
+        // Find a good position for the new glyph into the texture
+        glyph.textureRect = findGlyphRect(page, glyph.bounds.width, glyph.bounds.height);
+
+        // Write the pixels to the texture (the glyphs are white, only their alpha is stored)
+        unsigned int x = glyph.textureRect.left + padding;
+        unsigned int y = glyph.textureRect.top + padding;
+        unsigned int w = glyph.textureRect.width - 2 * padding;
+        unsigned int h = glyph.textureRect.height - 2 * padding;
+        page.texture.updateAlpha(&m_pixelBuffer[0], w, h, x, y);
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_BitmapGlyph bitmapGlyph = (FT_BitmapGlyph)glyphDesc;
-    FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    // Done :)
+    return glyph;
+}
+
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (bold && !outline)
+////////////////////////////////////////////////////////////
+IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+{
+    IntRect rect;
+    while (!packGlyphRect(page, width, height, rect))
     {
-        FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        // The texture can grow up to the budget, if any
+        unsigned int maximumSize = Texture::getMaximumSize();
+        if ((m_atlasBudget > 0) && (m_atlasBudget < maximumSize))
+            maximumSize = m_atlasBudget;
+
+        unsigned int textureWidth  = page.texture.getSize().x;
+        unsigned int textureHeight = page.texture.getSize().y;
+        if ((textureWidth * 2 <= maximumSize) && (textureHeight * 2 <= maximumSize))
+        {
+            // Make the texture 2 times bigger
+            std::vector<Uint8> previous(textureWidth * textureHeight);
+            page.texture.copyAlpha(&previous[0]);
+            std::vector<Uint8> pixels(textureWidth * textureHeight * 4, 0);
+            copyPixels(previous, textureWidth, IntRect(0, 0, textureWidth, textureHeight), pixels, textureWidth * 2, 0, 0);
+            page.texture.create(textureWidth * 2, textureHeight * 2, true);
+            page.texture.updateAlpha(&pixels[0], textureWidth * 2, textureHeight * 2, 0, 0);
+
+            // The new right half of the texture is empty
+            page.skyline.push_back(SkylineNode(textureWidth, 0, textureWidth));
+        }
+        else if (!evictGlyphs(page, false) && !evictGlyphs(page, true))
+        {
+            // Oops, we've reached the maximum texture size...
+            err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+            return IntRect(0, 0, 2, 2);
+        }
     }
 
-    // Compute the glyph's advance offset
-    glyph.advance = glyphDesc->advance.x >> 16;
-    if (bold)
-        glyph.advance += weight >> 6;
+    return rect;
+}
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
-    if ((width > 0) && (height > 0))
+
+////////////////////////////////////////////////////////////
+bool Font::packGlyphRect(Page& page, unsigned int width, unsigned int height, IntRect& rect) const
+{
+    std::vector<SkylineNode>& skyline = page.skyline;
+    unsigned int textureWidth  = page.texture.getSize().x;
+    unsigned int textureHeight = page.texture.getSize().y;
+
+    // Find the lowest position where the rectangle fits, the leftmost one in case of tie
+    std::size_t best = skyline.size();
+    unsigned int bestY = textureHeight;
+    for (std::size_t i = 0; (i < skyline.size()) && (skyline[i].x + width <= textureWidth); ++i)
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbours
-        const unsigned int padding = 1;
+        // The rectangle rests on the highest segment that it covers
+        unsigned int y = 0;
+        unsigned int remaining = width;
+        for (std::size_t j = i; remaining > 0; ++j)
+        {
+            y = std::max(y, skyline[j].y);
+            remaining -= std::min(remaining, skyline[j].width);
+        }
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        if ((y + height <= textureHeight) && (y < bestY))
+        {
+            best = i;
+            bestY = y;
+        }
+    }
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
+    if (best == skyline.size())
+        return false;
+
+    rect = IntRect(skyline[best].x, bestY, width, height);
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   = bitmapGlyph->left - padding;
-        glyph.bounds.top    = -bitmapGlyph->top - padding;
-        glyph.bounds.width  = width + 2 * padding;
-        glyph.bounds.height = height + 2 * padding;
+    // Raise the skyline above the rectangle, shrinking or removing the segments that it covers
+    skyline.insert(skyline.begin() + best, SkylineNode(rect.left, bestY + height, width));
+    unsigned int right = rect.left + width;
+    while ((best + 1 < skyline.size()) && (skyline[best + 1].x < right))
+    {
+        SkylineNode& node = skyline[best + 1];
+        unsigned int covered = right - node.x;
+        if (node.width > covered)
+        {
+            node.x += covered;
+            node.width -= covered;
+            break;
+        }
 
-        // Extract the glyph's pixels from the bitmap
-        m_pixelBuffer.resize(width * height * 4, 255);
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        skyline.erase(skyline.begin() + best + 1);
+    }
+
+    // Merge the neighbour segments that now have the same height
+    for (std::size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
         {
-            // Pixels are 1 bit monochrome values
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
         }
         else
         {
-            // Pixels are 8 bits gray levels
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = pixels[x];
-                }
-                pixels += bitmap.pitch;
-            }
+            ++i;
         }
-
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left + padding;
-        unsigned int y = glyph.textureRect.top + padding;
-        unsigned int w = glyph.textureRect.width - 2 * padding;
-        unsigned int h = glyph.textureRect.height - 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
     }
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
-
-    // Force an OpenGL flush, so that the font's texture will appear updated
-    // in all contexts immediately (solves problems in multi-threaded apps)
-    glCheck(glFlush());
+    page.usedArea += width * height;
 
-    // Done :)
-    return glyph;
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+bool Font::evictGlyphs(Page& page, bool evictRecent) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
-    {
-        float ratio = static_cast<float>(height) / it->height;
+    // Without budget, glyphs are never evicted
+    if (m_atlasBudget == 0)
+        return false;
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
+    // Evict the glyphs that were not used recently. The glyphs used in the current frame
+    // may already be referenced by geometry (or by vertices waiting in a render target
+    // batch), so they stay where they are; the other ones are packed again around them,
+    // from the tallest to the smallest
+    std::vector<std::pair<int, std::size_t> > moved;
+    unsigned int evicted = 0;
+    for (std::size_t i = 0; i < page.glyphs.size(); ++i)
+    {
+        CachedGlyph& cached = page.glyphs[i];
+        if (!cached.resident || (cached.glyph.textureRect.width == 0))
             continue;
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+        if ((m_frame - cached.lastUse > m_unusedFrames) || (evictRecent && (cached.lastUse != m_frame)))
+        {
+            cached.resident = false;
+            evicted++;
+        }
+        else if (cached.lastUse != m_frame)
+        {
+            // Taken out of the texture until it is packed again below
+            cached.resident = false;
+            moved.push_back(std::make_pair(-cached.glyph.textureRect.height, i));
+        }
+    }
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+    if (evicted == 0)
+    {
+        for (std::size_t i = 0; i < moved.size(); ++i)
+            page.glyphs[moved[i].second].resident = true;
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
+        return false;
+    }
+
+    std::sort(moved.begin(), moved.end());
+
+    // The skyline cannot reuse the holes left by the evicted glyphs: start a new
+    // set of pixels with the glyphs of the current frame at their current place
+    Vector2u size = page.texture.getSize();
+    std::vector<Uint8> previous(size.x * size.y);
+    page.texture.copyAlpha(&previous[0]);
+    std::vector<Uint8> pixels;
+    createPagePixels(pixels, size.x, size.y);
+    for (std::deque<CachedGlyph>::const_iterator it = page.glyphs.begin(); it != page.glyphs.end(); ++it)
+    {
+        if (it->resident && (it->glyph.textureRect.width > 0))
+            copyPixels(previous, size.x, it->glyph.textureRect, pixels, size.x, it->glyph.textureRect.left, it->glyph.textureRect.top);
     }
+    page.rebuildSkyline();
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    for (std::size_t i = 0; i < moved.size(); ++i)
     {
-        int rowHeight = height + height / 10;
-        while (page.nextRow + rowHeight >= page.texture.getSize().y)
+        CachedGlyph& cached = page.glyphs[moved[i].second];
+
+        IntRect rect;
+        if (packGlyphRect(page, cached.glyph.textureRect.width, cached.glyph.textureRect.height, rect))
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
-            }
-            else
-            {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
-            }
+            copyPixels(previous, size.x, cached.glyph.textureRect, pixels, size.x, rect.left, rect.top);
+            cached.glyph.textureRect = rect;
+            cached.resident = true;
+        }
+        else
+        {
+            evicted++;
         }
-
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
     }
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
-
-    // Update the row informations
-    row->width += width;
+    page.texture.updateAlpha(&pixels[0], size.x, size.y, 0, 0);
+    page.evictions += evicted;
+    page.repacks++;
+    page.revision++;
 
-    return rect;
+    return true;
 }
 
 
@@ -596,22 +1408,181 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Font::computeFontHash() const
+{
+    Uint64 hash = (static_cast<Uint64>(0xCBF29CE4) << 32) | 0x84222325;
+    char chunk[4096];
+
+    if (m_memoryData)
+    {
+        hashBytes(hash, static_cast<const char*>(m_memoryData), m_memorySize);
+    }
+    else if (!m_fileName.empty())
+    {
+        std::ifstream file(m_fileName.c_str(), std::ios_base::binary);
+        while (file.read(chunk, sizeof(chunk)) || (file.gcount() > 0))
+            hashBytes(hash, chunk, static_cast<std::size_t>(file.gcount()));
+    }
+    else if (m_streamRec)
+    {
+        // FreeType seeks before every read, so we can move the stream
+        InputStream* stream = static_cast<InputStream*>(static_cast<FT_StreamRec*>(m_streamRec)->descriptor.pointer);
+        stream->seek(0);
+        Int64 count;
+        while ((count = stream->read(chunk, sizeof(chunk))) > 0)
+            hashBytes(hash, chunk, static_cast<std::size_t>(count));
+    }
+
+    return hash;
+}
+
+
+////////////////////////////////////////////////////////////
+int Font::loadKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    {
+        // Convert the characters to indices
+        FT_UInt index1 = FT_Get_Char_Index(face, first);
+        FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+        // Get the kerning vector
+        FT_Vector kerning;
+        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+
+        // Return the X advance
+        return kerning.x >> 6;
+    }
+    else
+    {
+        // Invalid font, or no kerning
+        return 0;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+evictions(0),
+repacks  (0),
+revision (0)
 {
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    std::memset(latin, 0, sizeof(latin));
 
-    // Reserve a 2x2 white square for texturing underlines
-    for (int x = 0; x < 2; ++x)
-        for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
+    // Make sure that the texture is initialized by default
+    std::vector<Uint8> pixels;
+    createPagePixels(pixels, 128, 128);
 
-    // Create the texture
-    texture.loadFromImage(image);
+    // Create the texture; only the alpha of the glyphs is stored, they are sampled as white
+    texture.create(128, 128, true);
+    texture.updateAlpha(&pixels[0], 128, 128, 0, 0);
     texture.setSmooth(true);
+
+    resetSkyline();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::Page::resetSkyline()
+{
+    // Glyphs start on the left of the texture, except under the white square reserved for underlines
+    skyline.clear();
+    skyline.push_back(SkylineNode(0, 3, 3));
+    skyline.push_back(SkylineNode(3, 0, texture.getSize().x - 3));
+    usedArea = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::Page::rebuildSkyline()
+{
+    // Follow the bottom of the lowest glyph of each column, starting with the white square reserved for underlines
+    std::vector<unsigned int> heights(texture.getSize().x, 0);
+    heights[0] = heights[1] = heights[2] = 3;
+    usedArea = 0;
+    for (std::deque<CachedGlyph>::const_iterator it = glyphs.begin(); it != glyphs.end(); ++it)
+    {
+        if (!it->resident)
+            continue;
+
+        const IntRect& rect = it->glyph.textureRect;
+        for (int x = rect.left; x < rect.left + rect.width; ++x)
+            heights[x] = std::max(heights[x], static_cast<unsigned int>(rect.top + rect.height));
+        usedArea += rect.width * rect.height;
+    }
+
+    skyline.clear();
+    for (unsigned int x = 0; x < heights.size(); ++x)
+    {
+        if (!skyline.empty() && (skyline.back().y == heights[x]))
+            skyline.back().width++;
+        else
+            skyline.push_back(SkylineNode(x, heights[x], 1));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename Key>
+T* Font::HashTable<T, Key>::find(Key key) const
+{
+    if (entries.empty())
+        return NULL;
+
+    // Linear probing; the table is never full, so the loop always ends on an unused slot
+    std::size_t mask = entries.size() - 1;
+    for (std::size_t i = hash(key) & mask; ; i = (i + 1) & mask)
+    {
+        const Entry& entry = entries[i];
+        if (!entry.used)
+            return NULL;
+        if (entry.key == key)
+            return const_cast<T*>(&entry.value);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename Key>
+void Font::HashTable<T, Key>::insert(Key key, const T& value)
+{
+    // Keep the load factor below 1/2, so that probe sequences stay short
+    if ((count + 1) * 2 > entries.size())
+    {
+        std::vector<Entry> previous(entries.size() < 16 ? 16 : entries.size() * 2);
+        previous.swap(entries);
+
+        count = 0;
+        for (std::size_t i = 0; i < previous.size(); ++i)
+        {
+            if (previous[i].used)
+                insert(previous[i].key, previous[i].value);
+        }
+    }
+
+    std::size_t mask = entries.size() - 1;
+    std::size_t i = hash(key) & mask;
+    while (entries[i].used && (entries[i].key != key))
+        i = (i + 1) & mask;
+
+    if (!entries[i].used)
+        count++;
+
+    entries[i].key = key;
+    entries[i].value = value;
+    entries[i].used = true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename Key>
+void Font::HashTable<T, Key>::clear()
+{
+    entries.clear();
+    count = 0;
 }
 
 } // namespace sf
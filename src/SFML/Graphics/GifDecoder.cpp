@@ -0,0 +1,431 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2012 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GifDecoder.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include "giflib/gif_lib.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Get a printable description of a giflib error code
+    const char* getErrorString(int error)
+    {
+        const char* message = GifErrorString(error);
+        return message ? message : "Unknown error";
+    }
+
+    // Row order of the four passes of an interlaced image
+    const int interlaceOffsets[] = {0, 4, 2, 1};
+    const int interlaceJumps[]   = {8, 8, 4, 2};
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GifDecoder::GifDecoder() :
+m_file       (NULL),
+m_stream     (NULL),
+m_size       (0, 0),
+m_frameCount (0),
+m_disposal   (Unspecified),
+m_delay      (0),
+m_transparent(NO_TRANSPARENT_COLOR)
+{
+    m_memory.data   = NULL;
+    m_memory.size   = 0;
+    m_memory.offset = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+GifDecoder::~GifDecoder()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::openFromFile(const std::string& filename)
+{
+    close();
+
+    int error = 0;
+    GifFileType* file = DGifOpenFileName(filename.c_str(), &error);
+
+    return initialize(file, error, "\"" + filename + "\"");
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::openFromMemory(const void* data, std::size_t size)
+{
+    close();
+
+    m_memory.data   = static_cast<const Uint8*>(data);
+    m_memory.size   = size;
+    m_memory.offset = 0;
+
+    int error = 0;
+    GifFileType* file = DGifOpen(&m_memory, &MemorySource::read, &error);
+
+    return initialize(file, error, "from memory");
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::openFromStream(InputStream& stream)
+{
+    close();
+
+    m_stream = &stream;
+    m_stream->seek(0);
+
+    int error = 0;
+    GifFileType* file = DGifOpen(m_stream, &GifDecoder::readFromStream, &error);
+
+    return initialize(file, error, "from stream");
+}
+
+
+////////////////////////////////////////////////////////////
+void GifDecoder::close()
+{
+    if (m_file)
+    {
+        DGifCloseFile(m_file);
+        m_file = NULL;
+    }
+
+    m_stream = NULL;
+    m_memory.data = NULL;
+    m_size = Vector2u(0, 0);
+    m_canvas.clear();
+    m_previous.clear();
+    m_frameCount = 0;
+    m_disposal = Unspecified;
+    m_delay = 0;
+    m_transparent = NO_TRANSPARENT_COLOR;
+    m_frameRect = IntRect();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::readNextFrame(Image& frame)
+{
+    if (!readNextFrame())
+        return false;
+
+    frame.create(m_size.x, m_size.y, &m_canvas[0]);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::readNextFrame()
+{
+    if (!m_file)
+        return false;
+
+    // Defaults for a frame which is not preceded by a graphics control block
+    int disposal = Unspecified;
+    int delay = 0;
+    m_transparent = NO_TRANSPARENT_COLOR;
+
+    GifRecordType record;
+    do
+    {
+        if (DGifGetRecordType(m_file, &record) == GIF_ERROR)
+        {
+            err() << "Failed to decode gif frame " << m_frameCount << " (" << getErrorString(m_file->Error) << ")" << std::endl;
+            close();
+            return false;
+        }
+
+        switch (record)
+        {
+            case IMAGE_DESC_RECORD_TYPE :
+            {
+                if (DGifGetImageDesc(m_file) == GIF_ERROR)
+                {
+                    err() << "Failed to decode gif frame " << m_frameCount << " (" << getErrorString(m_file->Error) << ")" << std::endl;
+                    close();
+                    return false;
+                }
+
+                // Apply the disposal of the previous frame, then draw the new one on top
+                disposeFrame();
+                m_disposal = disposal;
+                m_delay = delay;
+                if (!decodeImage())
+                {
+                    close();
+                    return false;
+                }
+
+                m_frameCount++;
+                return true;
+            }
+
+            case EXTENSION_RECORD_TYPE :
+            {
+                int code = 0;
+                GifByteType* extension = NULL;
+                if (DGifGetExtension(m_file, &code, &extension) == GIF_ERROR)
+                {
+                    close();
+                    return false;
+                }
+
+                // Only the graphics control block is relevant for decoding the frames
+                if ((code == GRAPHICS_EXT_FUNC_CODE) && extension)
+                {
+                    GraphicsControlBlock gcb;
+                    if (DGifExtensionToGCB(extension[0], extension + 1, &gcb) == GIF_OK)
+                    {
+                        disposal = gcb.DisposalMode;
+                        delay = gcb.DelayTime;
+                        m_transparent = gcb.TransparentColor;
+                    }
+                }
+
+                // Skip the remaining sub-blocks
+                while (extension)
+                {
+                    if (DGifGetExtensionNext(m_file, &extension) == GIF_ERROR)
+                    {
+                        close();
+                        return false;
+                    }
+                }
+                break;
+            }
+
+            default :
+                break;
+        }
+    }
+    while (record != TERMINATE_RECORD_TYPE);
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u GifDecoder::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* GifDecoder::getPixelsPtr() const
+{
+    if (m_canvas.empty() || !m_frameCount)
+        return NULL;
+
+    return &m_canvas[0];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GifDecoder::getFrameCount() const
+{
+    return m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+int GifDecoder::getFrameDisposal() const
+{
+    return m_disposal;
+}
+
+
+////////////////////////////////////////////////////////////
+Time GifDecoder::getFrameDelay() const
+{
+    return milliseconds(m_delay * 10);
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::initialize(GifFileType* file, int error, const std::string& name)
+{
+    if (!file)
+    {
+        err() << "Failed to open gif file " << name << " (" << getErrorString(error) << ")" << std::endl;
+        m_stream = NULL;
+        m_memory.data = NULL;
+        return false;
+    }
+
+    m_file = file;
+
+    if ((m_file->SWidth <= 0) || (m_file->SHeight <= 0))
+    {
+        err() << "Failed to open gif file " << name << " (invalid canvas size)" << std::endl;
+        close();
+        return false;
+    }
+
+    // The canvas starts fully transparent
+    m_size.x = m_file->SWidth;
+    m_size.y = m_file->SHeight;
+    m_canvas.assign(m_size.x * m_size.y * 4, 0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GifDecoder::disposeFrame()
+{
+    if (!m_frameCount)
+        return;
+
+    if (m_disposal == ClearToColor)
+    {
+        // Clear the area of the previous frame to transparent, like browsers do
+        for (int y = m_frameRect.top; y < m_frameRect.top + m_frameRect.height; ++y)
+        {
+            Uint8* row = &m_canvas[(y * m_size.x + m_frameRect.left) * 4];
+            std::memset(row, 0, m_frameRect.width * 4);
+        }
+    }
+    else if ((m_disposal == RestorePrevious) && !m_previous.empty())
+    {
+        // Only the area covered by the previous frame has changed since the backup
+        for (int y = m_frameRect.top; y < m_frameRect.top + m_frameRect.height; ++y)
+        {
+            std::size_t offset = (y * m_size.x + m_frameRect.left) * 4;
+            std::memcpy(&m_canvas[offset], &m_previous[offset], m_frameRect.width * 4);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GifDecoder::decodeImage()
+{
+    const GifImageDesc& desc = m_file->Image;
+    const ColorMapObject* colorMap = desc.ColorMap ? desc.ColorMap : m_file->SColorMap;
+    if (!colorMap)
+    {
+        err() << "Failed to decode gif frame " << m_frameCount << " (no color map)" << std::endl;
+        return false;
+    }
+
+    // Clip the frame against the canvas
+    int left   = std::max(desc.Left, 0);
+    int top    = std::max(desc.Top, 0);
+    int right  = std::min(desc.Left + desc.Width, static_cast<int>(m_size.x));
+    int bottom = std::min(desc.Top + desc.Height, static_cast<int>(m_size.y));
+    m_frameRect = IntRect(left, top, std::max(right - left, 0), std::max(bottom - top, 0));
+
+    // Keep a backup of the canvas if this frame must be undone later
+    if (m_disposal == RestorePrevious)
+        m_previous = m_canvas;
+
+    if ((desc.Width <= 0) || (desc.Height <= 0))
+        return true;
+
+    m_line.resize(desc.Width);
+
+    const int passes = desc.Interlace ? 4 : 1;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        const int start = desc.Interlace ? interlaceOffsets[pass] : 0;
+        const int jump  = desc.Interlace ? interlaceJumps[pass] : 1;
+
+        for (int row = start; row < desc.Height; row += jump)
+        {
+            if (DGifGetLine(m_file, &m_line[0], desc.Width) == GIF_ERROR)
+            {
+                err() << "Failed to decode gif frame " << m_frameCount << " (" << getErrorString(m_file->Error) << ")" << std::endl;
+                return false;
+            }
+
+            const int y = desc.Top + row;
+            if ((y < top) || (y >= bottom))
+                continue;
+
+            Uint8* pixel = &m_canvas[(y * m_size.x + left) * 4];
+            for (int x = left; x < right; ++x, pixel += 4)
+            {
+                int index = m_line[x - desc.Left];
+                if ((index == m_transparent) || (index >= colorMap->ColorCount))
+                    continue;
+
+                const GifColorType& color = colorMap->Colors[index];
+                pixel[0] = color.Red;
+                pixel[1] = color.Green;
+                pixel[2] = color.Blue;
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    // giflib keeps a copy of every local color map; release it as we no longer need it
+    SavedImage& saved = m_file->SavedImages[m_file->ImageCount - 1];
+    if (saved.ImageDesc.ColorMap)
+    {
+        GifFreeMapObject(saved.ImageDesc.ColorMap);
+        saved.ImageDesc.ColorMap = NULL;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+int GifDecoder::MemorySource::read(GifFileType* file, Uint8* buffer, int size)
+{
+    MemorySource* memory = static_cast<MemorySource*>(file->UserData);
+
+    std::size_t count = std::min(static_cast<std::size_t>(size), memory->size - memory->offset);
+    std::memcpy(buffer, memory->data + memory->offset, count);
+    memory->offset += count;
+
+    return static_cast<int>(count);
+}
+
+
+////////////////////////////////////////////////////////////
+int GifDecoder::readFromStream(GifFileType* file, Uint8* buffer, int size)
+{
+    InputStream* stream = static_cast<InputStream*>(file->UserData);
+
+    Int64 count = stream->read(buffer, size);
+    return count > 0 ? static_cast<int>(count) : 0;
+}
+
+} // namespace sf
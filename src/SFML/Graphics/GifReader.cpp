@@ -25,22 +25,11 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include <SFML/Graphics.hpp>
-#include "giflib/gif_lib.h"
-
-#include <SFML/Graphics/Image.hpp>
-#include <SFML/Graphics/ImageLoader.hpp>
-#include <SFML/System/Err.hpp>
-#include <algorithm>
+#include <SFML/Graphics/GifReader.hpp>
+#include <SFML/Graphics/GifDecoder.hpp>
 #include <cstdlib>
 #include <cstring>
-#include <iomanip>
-#include <locale>
-#include <sstream>
-#include <string>
-#include <iostream>
-#include <fstream>
-#include <cstdio>
+#include <vector>
 
 
 namespace sf
@@ -66,235 +55,186 @@ GifReader::~GifReader()
 
 unsigned char* GifReader::Gif2RGB(std::string filename, int& width, int& height, int& numberOfFrames, int** frameDisposal)const
 {
-    unsigned char* output;
-    unsigned char* op;
-    GifFileType *GifFile;
-    GifColorType *ColorMapEntry;
-    ColorMapObject *ColorMap;
-    int Error;
-    GraphicsControlBlock GCB;
+    GifDecoder decoder;
+    if (!decoder.openFromFile(filename))
+        return 0;
 
+    std::vector<Uint8> pixels;
+    std::vector<int> disposals;
+    while (decoder.readNextFrame())
+    {
+        const Uint8* canvas = decoder.getPixelsPtr();
+        pixels.insert(pixels.end(), canvas, canvas + decoder.getSize().x * decoder.getSize().y * 4);
+        disposals.push_back(decoder.getFrameDisposal());
+    }
 
+    if (disposals.empty())
+        return 0;
 
-    if ((GifFile = DGifOpenFileName(filename.c_str(), &Error)) != NULL)
+    unsigned char* output = static_cast<unsigned char*>(malloc(pixels.size()));
+    *frameDisposal = static_cast<int*>(malloc(disposals.size() * sizeof(int)));
+    if (!output || !*frameDisposal)
     {
-        if(DGifSlurp(GifFile) == GIF_ERROR)
-            exit(1);
+        free(output);
+        free(*frameDisposal);
+        *frameDisposal = 0;
+        return 0;
+    }
 
-        numberOfFrames = GifFile->ImageCount;
-        width = GifFile->Image.Width;
-        height = GifFile->Image.Height;
+    memcpy(output, &pixels[0], pixels.size());
+    memcpy(*frameDisposal, &disposals[0], disposals.size() * sizeof(int));
 
-        if ((output = (unsigned char *) malloc(width * height * numberOfFrames * 4)) == NULL)
-            exit(4);
+    width = decoder.getSize().x;
+    height = decoder.getSize().y;
+    numberOfFrames = static_cast<int>(disposals.size());
 
-        op = output;
+    return output;
+}
 
-        ColorMap = (GifFile->Image.ColorMap ? GifFile->Image.ColorMap : GifFile->SColorMap);
-        if (ColorMap == NULL)
-        {
-            exit(4);
-        }
 
-        if ((*frameDisposal = (int *) malloc(numberOfFrames * 4)) == NULL)
-            exit(4);
 
-        for(int y=0; y < numberOfFrames; y++)
-        {
-            DGifSavedExtensionToGCB(GifFile, y, &GCB);
-            (*frameDisposal)[y] = GCB.DisposalMode;
 
-            for(int x=0; x < width*height; x++)
+namespace
+{
+    // Open a gif file and decode it up to the given frame; the index wraps
+    // around the number of frames, which is only known once the end is reached
+    bool seekFrame(GifDecoder& decoder, const std::string& filename, int& frameNumber)
+    {
+        if ((frameNumber < 0) || !decoder.openFromFile(filename))
+            return false;
+
+        while (decoder.getFrameCount() <= static_cast<unsigned int>(frameNumber))
+        {
+            if (!decoder.readNextFrame())
             {
-                ColorMapEntry = &ColorMap->Colors[GifFile->SavedImages[y].RasterBits[x]];
-                *op++ = ColorMapEntry->Red;
-                *op++ = ColorMapEntry->Green;
-                *op++ = ColorMapEntry->Blue;
-                if(GifFile->SavedImages[y].RasterBits[x] == GCB.TransparentColor)
-                    *op++ = 0;
-                else
-                    *op++ = 255;
+                unsigned int count = decoder.getFrameCount();
+                if (!count)
+                    return false;
+
+                frameNumber = frameNumber % count;
+                return seekFrame(decoder, filename, frameNumber);
             }
         }
 
-
-        if (DGifCloseFile(GifFile) == GIF_ERROR)
-            exit(2);
-
-        return output;
+        return true;
     }
-
-
-
-    return 0;
 }
 
 
 
 
-
 unsigned char* GifReader::GetImageByIndex(std::string filename, int& framewidth, int& frameheight, int& frameNumber, int** frameDisposal)const
 {
-    int width, height;
-    int nf;//returns the number of frames in gif
-    sf::Color c;
-    unsigned char* op;
-    unsigned char* out;
-    unsigned char* outp;
-    GifFileType *GifFile;
-    GifColorType *ColorMapEntry;
-    ColorMapObject *ColorMap;
-    int Error;
-    SavedImage* sv;
-    GraphicsControlBlock GCB;
-
-
-
-    if ((GifFile = DGifOpenFileName(filename.c_str(), &Error)) != NULL)
+    GifDecoder decoder;
+    if (!seekFrame(decoder, filename, frameNumber))
+        return 0;
+
+    std::size_t size = decoder.getSize().x * decoder.getSize().y * 4;
+    unsigned char* out = static_cast<unsigned char*>(malloc(size));
+    *frameDisposal = static_cast<int*>(malloc(sizeof(int)));
+    if (!out || !*frameDisposal)
     {
-        if(DGifSlurp(GifFile) == GIF_ERROR)
-            exit(1);
-
-        nf = GifFile->ImageCount;
-        width = GifFile->Image.Width;
-        height = GifFile->Image.Height;
-
-        if ((out = (unsigned char *) malloc(width * height * 4)) == NULL)
-            exit(4);
+        free(out);
+        free(*frameDisposal);
+        *frameDisposal = 0;
+        return 0;
+    }
 
-        outp = out;
+    memcpy(out, decoder.getPixelsPtr(), size);
+    **frameDisposal = decoder.getFrameDisposal();
+    framewidth = decoder.getSize().x;
+    frameheight = decoder.getSize().y;
 
-        ColorMap = (GifFile->Image.ColorMap ? GifFile->Image.ColorMap : GifFile->SColorMap);
-        if (ColorMap == NULL)
-        {
-            exit(4);
-        }
+    return out;
+}
 
-        if ((*frameDisposal = (int *) malloc(4)) == NULL)
-            exit(4);
 
-        frameNumber = frameNumber % nf;
-        sv = &GifFile->SavedImages[frameNumber];
-        op = sv->RasterBits;
-        DGifSavedExtensionToGCB(GifFile, frameNumber, &GCB);
-        **frameDisposal = GCB.DisposalMode;
 
-        for(int y = 0; y < height; y++)
-            for(int x = 0; x < width; x++)
-            {
-                ColorMapEntry = &ColorMap->Colors[*op];
-                *outp++ = ColorMapEntry->Red;
-                *outp++ = ColorMapEntry->Green;
-                *outp++ = ColorMapEntry->Blue;
-                if(*op++ == GCB.TransparentColor)
-                    *outp++ = 0;
-                else
-                    *outp++ = 255;
-            }
 
-        if (DGifCloseFile(GifFile) == GIF_ERROR)
-            exit(2);
+int GifReader::GetImageByIndex(Image& i, int& frameNumber, std::string filename)const
+{
+    GifDecoder decoder;
+    if (!seekFrame(decoder, filename, frameNumber))
+        return 0;
 
-        return out;
-    }
+    i.create(decoder.getSize().x, decoder.getSize().y, decoder.getPixelsPtr());
 
-    return 0;
+    return decoder.getFrameDisposal();
 }
 
 
 
 
-int GifReader::GetImageByIndex(Image& i, int& frameNumber, std::string filename)const
+bool GifReader::loadGifAnimationFromFile(const std::string& filename)
 {
-    int width, height;
-    int nf;//returns the number of frames in gif
-    sf::Color c;
-    unsigned char* op;
-    GifFileType *GifFile;
-    GifColorType *ColorMapEntry;
-    ColorMapObject *ColorMap;
-    int Error;
-    SavedImage* sv;
-    GraphicsControlBlock GCB;
-
-
+    GifDecoder decoder;
+    if (!decoder.openFromFile(filename))
+        return false;
 
-    if ((GifFile = DGifOpenFileName(filename.c_str(), &Error)) != NULL)
-    {
-        if(DGifSlurp(GifFile) == GIF_ERROR)
-            exit(1);
+    return loadGifAnimation(decoder);
+}
 
-        nf = GifFile->ImageCount;
-        width = GifFile->Image.Width;
-        height = GifFile->Image.Height;
 
-        ColorMap = (GifFile->Image.ColorMap ? GifFile->Image.ColorMap : GifFile->SColorMap);
-        if (ColorMap == NULL)
-        {
-            exit(4);
-        }
 
-        sf::Vector2u s = i.getSize();
-        if(s.x != width || s.y != height)
-        {
-            ColorMapEntry = &ColorMap->Colors[GifFile->SBackGroundColor];
-            c.r = ColorMapEntry->Red;
-            c.g = ColorMapEntry->Green;
-            c.b = ColorMapEntry->Blue;
-            i.create(width, height, c);
-        }
+bool GifReader::loadGifAnimationFromMemory(const void* data, std::size_t size)
+{
+    GifDecoder decoder;
+    if (!decoder.openFromMemory(data, size))
+        return false;
 
-        frameNumber = frameNumber % nf;
-        sv = &GifFile->SavedImages[frameNumber];
-        op = sv->RasterBits;
-        DGifSavedExtensionToGCB(GifFile, frameNumber, &GCB);
+    return loadGifAnimation(decoder);
+}
 
-        for(int y = 0; y < height; y++)
-            for(int x = 0; x < width; x++)
-            {
-                if(*op == GCB.TransparentColor)
-                    c.a = 0;
-                else
-                    c.a = 255;
-
-                ColorMapEntry = &ColorMap->Colors[*op++];
-                c.r = ColorMapEntry->Red;
-                c.g = ColorMapEntry->Green;
-                c.b = ColorMapEntry->Blue;
-                i.setPixel(x,y,c);
-            }
 
-        if (DGifCloseFile(GifFile) == GIF_ERROR)
-            exit(2);
 
-        return GCB.DisposalMode;
-    }
+bool GifReader::loadGifAnimationFromStream(InputStream& stream)
+{
+    GifDecoder decoder;
+    if (!decoder.openFromStream(stream))
+        return false;
 
-    return 0;
+    return loadGifAnimation(decoder);
 }
 
 
 
-
-bool GifReader::loadGifAnimationFromFile(const std::string& filename)
+bool GifReader::loadGifAnimation(GifDecoder& decoder)
 {
-    m_pixels.clear();
-    unsigned char* p = Gif2RGB(filename.c_str(), fwidth, fheight, totalFrames, &fdisposal);
+    const Vector2u size = decoder.getSize();
+    const std::size_t frameSize = size.x * size.y * 4;
+
+    // Frames are stacked from top to bottom, decoded in a single pass over the file
+    std::vector<Uint8> pixels;
+    std::vector<int> disposals;
+    while (decoder.readNextFrame())
+    {
+        if (size.y * (disposals.size() + 1) > 8191)//height can not be greater than 8192
+            return false;
 
-    if(!p)
+        pixels.resize(pixels.size() + frameSize);
+        memcpy(&pixels[pixels.size() - frameSize], decoder.getPixelsPtr(), frameSize);
+        disposals.push_back(decoder.getFrameDisposal());
+    }
+
+    if (disposals.empty())
         return false;
 
-    if(fheight*totalFrames > 8191){//height can not be greater than 8192
-        free(p);
+    int* disposal = static_cast<int*>(malloc(disposals.size() * sizeof(int)));
+    if (!disposal)
         return false;
-    }
+    memcpy(disposal, &disposals[0], disposals.size() * sizeof(int));
+
+    if(fdisposal)
+        free(fdisposal);
+    fdisposal = disposal;
+
+    fwidth = size.x;
+    fheight = size.y;
+    totalFrames = static_cast<int>(disposals.size());
 
     m_size.x = fwidth;
     m_size.y = fheight*totalFrames;
-
-    m_pixels.resize(fwidth * fheight * totalFrames * 4);
-    memcpy(&m_pixels[0], p, m_pixels.size());
-    free (p);
+    m_pixels.swap(pixels);
 
     return true;
 }
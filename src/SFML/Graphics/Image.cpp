@@ -31,6 +31,208 @@
 #include <algorithm>
 #include <cstring>
 
+// Select the SIMD instructions used by the pixel operations
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_USE_NEON
+#endif
+
+
+namespace
+{
+    // Pack the components of a pixel into a 32-bit word, with the byte order of the pixels in memory
+    sf::Uint32 toPixel(sf::Uint8 r, sf::Uint8 g, sf::Uint8 b, sf::Uint8 a)
+    {
+        const sf::Uint8 components[] = {r, g, b, a};
+        sf::Uint32 pixel;
+        std::memcpy(&pixel, components, sizeof(pixel));
+        return pixel;
+    }
+
+    // Divide a value by 255 without a division; exact for products of two components (up to 255 * 255)
+    inline unsigned int divide255(unsigned int value)
+    {
+        return (value + 1 + (value >> 8)) >> 8;
+    }
+
+#if defined(SFML_IMAGE_USE_SSE2)
+
+    // Blend two pixels over two other ones, their components being extended to 16 bits
+    inline __m128i blendPixelPair(__m128i source, __m128i dest)
+    {
+        // Broadcast the alpha of each pixel to its components; the alpha
+        // component only keeps the destination term, the source alpha is added after the division
+        const __m128i colorLanes = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        __m128i value = _mm_add_epi16(_mm_mullo_epi16(source, _mm_and_si128(alpha, colorLanes)), _mm_mullo_epi16(dest, inverse));
+        value = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(value, _mm_set1_epi16(1)), _mm_srli_epi16(value, 8)), 8);
+        return _mm_add_epi16(value, _mm_andnot_si128(colorLanes, alpha));
+    }
+
+#elif defined(SFML_IMAGE_USE_NEON)
+
+    // Divide 16-bit products by 255 and narrow them to 8 bits, like divide255
+    inline uint8x8_t divide255(uint16x8_t value)
+    {
+        return vmovn_u16(vshrq_n_u16(vaddq_u16(vaddq_u16(value, vdupq_n_u16(1)), vshrq_n_u16(value, 8)), 8));
+    }
+
+#endif
+
+    // Fill pixels with a color
+    void fillPixels(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_USE_SSE2)
+        const __m128i pattern = _mm_set1_epi32(static_cast<int>(color));
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), pattern);
+#elif defined(SFML_IMAGE_USE_NEON)
+        const uint8x16_t pattern = vreinterpretq_u8_u32(vdupq_n_u32(color));
+        for (; i + 4 <= count; i += 4)
+            vst1q_u8(pixels + i * 4, pattern);
+#endif
+
+        for (; i < count; ++i)
+            std::memcpy(pixels + i * 4, &color, sizeof(color));
+    }
+
+    // Replace the alpha of the pixels equal to a color, or of all the pixels
+    void replaceAlpha(sf::Uint8* pixels, std::size_t count, bool all, sf::Uint32 color, sf::Uint8 alpha)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_USE_SSE2)
+        // Four pixels per iteration, compared as 32-bit words
+        const __m128i key        = _mm_set1_epi32(static_cast<int>(color));
+        const __m128i alphaMask  = _mm_set1_epi32(static_cast<int>(toPixel(0, 0, 0, 255)));
+        const __m128i alphaValue = _mm_set1_epi32(static_cast<int>(toPixel(0, 0, 0, alpha)));
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i values = _mm_loadu_si128(block);
+            __m128i match = all ? alphaMask : _mm_and_si128(_mm_cmpeq_epi32(values, key), alphaMask);
+            _mm_storeu_si128(block, _mm_or_si128(_mm_andnot_si128(match, values), _mm_and_si128(match, alphaValue)));
+        }
+#elif defined(SFML_IMAGE_USE_NEON)
+        const uint32x4_t key        = vdupq_n_u32(color);
+        const uint8x16_t alphaMask  = vreinterpretq_u8_u32(vdupq_n_u32(toPixel(0, 0, 0, 255)));
+        const uint8x16_t alphaValue = vdupq_n_u8(alpha);
+        for (; i + 4 <= count; i += 4)
+        {
+            uint8x16_t values = vld1q_u8(pixels + i * 4);
+            uint8x16_t match = all ? alphaMask : vandq_u8(vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(values), key)), alphaMask);
+            vst1q_u8(pixels + i * 4, vbslq_u8(match, alphaValue, values));
+        }
+#endif
+
+        if (all)
+        {
+            for (; i < count; ++i)
+                pixels[i * 4 + 3] = alpha;
+        }
+        else
+        {
+            for (; i < count; ++i)
+            {
+                sf::Uint32 pixel;
+                std::memcpy(&pixel, pixels + i * 4, sizeof(pixel));
+                pixels[i * 4 + 3] = (pixel == color) ? alpha : pixels[i * 4 + 3];
+            }
+        }
+    }
+
+    // Blend a row of pixels over another one, using the alpha of the source pixels
+    void blendPixels(const sf::Uint8* source, sf::Uint8* dest, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_USE_SSE2)
+        // Four pixels per iteration, extended to 16-bit components
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+            __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i * 4));
+            __m128i low = blendPixelPair(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+            __m128i high = blendPixelPair(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 4), _mm_packus_epi16(low, high));
+        }
+#elif defined(SFML_IMAGE_USE_NEON)
+        // Eight pixels per iteration, split into one register per component
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t src = vld4_u8(source + i * 4);
+            uint8x8x4_t dst = vld4_u8(dest + i * 4);
+            uint8x8_t alpha = src.val[3];
+            uint8x8_t inverse = vsub_u8(vdup_n_u8(255), alpha);
+            for (int c = 0; c < 3; ++c)
+                dst.val[c] = divide255(vmlal_u8(vmull_u8(src.val[c], alpha), dst.val[c], inverse));
+            dst.val[3] = vadd_u8(alpha, divide255(vmull_u8(dst.val[3], inverse)));
+            vst4_u8(dest + i * 4, dst);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* src = source + i * 4;
+            sf::Uint8*       dst = dest + i * 4;
+
+            // Interpolate RGBA components using the alpha value of the source pixel
+            unsigned int alpha = src[3];
+            dst[0] = static_cast<sf::Uint8>(divide255(src[0] * alpha + dst[0] * (255 - alpha)));
+            dst[1] = static_cast<sf::Uint8>(divide255(src[1] * alpha + dst[1] * (255 - alpha)));
+            dst[2] = static_cast<sf::Uint8>(divide255(src[2] * alpha + dst[2] * (255 - alpha)));
+            dst[3] = static_cast<sf::Uint8>(alpha + divide255(dst[3] * (255 - alpha)));
+        }
+    }
+
+    // Reverse the order of a row of pixels, in place
+    void reversePixels(sf::Uint8* row, std::size_t count)
+    {
+        sf::Uint8* left = row;
+        sf::Uint8* right = row + count * 4;
+
+#if defined(SFML_IMAGE_USE_SSE2)
+        // Swap four pixels from each end per iteration
+        while (right - left >= 32)
+        {
+            right -= 16;
+            __m128i leftPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+            __m128i rightPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(rightPixels, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(leftPixels, _MM_SHUFFLE(0, 1, 2, 3)));
+            left += 16;
+        }
+#elif defined(SFML_IMAGE_USE_NEON)
+        while (right - left >= 32)
+        {
+            right -= 16;
+            uint32x4_t leftPixels = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(left)));
+            uint32x4_t rightPixels = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(right)));
+            vst1q_u8(left, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(rightPixels), vget_low_u32(rightPixels))));
+            vst1q_u8(right, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(leftPixels), vget_low_u32(leftPixels))));
+            left += 16;
+        }
+#endif
+
+        while (right - left >= 8)
+        {
+            right -= 4;
+            sf::Uint8 pixel[4];
+            std::memcpy(pixel, left, 4);
+            std::memcpy(left, right, 4);
+            std::memcpy(right, pixel, 4);
+            left += 4;
+        }
+    }
+}
+
 
 namespace sf
 {
@@ -61,15 +263,7 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         m_pixels.resize(width * height * 4);
 
         // Fill it with the specified color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        fillPixels(&m_pixels[0], width * height, toPixel(color.r, color.g, color.b, color.a));
     }
     else
     {
@@ -147,14 +341,7 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        replaceAlpha(&m_pixels[0], m_size.x * m_size.y, false, toPixel(color.r, color.g, color.b, color.a), alpha);
     }
 }
 
@@ -211,23 +398,10 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            blendPixels(srcPixels, dstPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -284,22 +458,9 @@ void Image::flipHorizontally()
 {
     if (!m_pixels.empty())
     {
-        std::vector<Uint8> before = m_pixels;
+        // Reverse each row in place
         for (unsigned int y = 0; y < m_size.y; ++y)
-        {
-            const Uint8* source = &before[y * m_size.x * 4];
-            Uint8* dest = &m_pixels[(y + 1) * m_size.x * 4 - 4];
-            for (unsigned int x = 0; x < m_size.x; ++x)
-            {
-                dest[0] = source[0];
-                dest[1] = source[1];
-                dest[2] = source[2];
-                dest[3] = source[3];
-
-                source += 4;
-                dest -= 4;
-            }
-        }
+            reversePixels(&m_pixels[y * m_size.x * 4], m_size.x);
     }
 }
 
@@ -309,16 +470,19 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        std::vector<Uint8> before = m_pixels;
-        const Uint8* source = &before[m_size.x * (m_size.y - 1) * 4];
-        Uint8* dest = &m_pixels[0];
+        // Swap the rows from both ends, through a single row of temporary storage
         std::size_t rowSize = m_size.x * 4;
+        std::vector<Uint8> row(rowSize);
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[m_size.x * (m_size.y - 1) * 4];
 
-        for (unsigned int y = 0; y < m_size.y; ++y)
+        while (top < bottom)
         {
-            std::memcpy(dest, source, rowSize);
-            source -= rowSize;
-            dest += rowSize;
+            std::memcpy(&row[0], top, rowSize);
+            std::memcpy(top, bottom, rowSize);
+            std::memcpy(bottom, &row[0], rowSize);
+            top += rowSize;
+            bottom -= rowSize;
         }
     }
 }
@@ -331,14 +495,16 @@ void Image::setAlpha(unsigned int alpha){
 	if(alpha <= 255)//set base level
 		a = alpha;
 
-	if (!m_pixels.empty()){
-		Uint8* head = &m_pixels[3];
-		Uint8* tail = &m_pixels[(m_size.y * m_size.x * 4)-1];
-		while(head != tail){
-			*head = a;
-			head+=4;
-		}
-	}
+	if (!m_pixels.empty())
+		replaceAlpha(&m_pixels[0], m_size.x * m_size.y, true, 0, static_cast<Uint8>(a));
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::swap(Image& right)
+{
+    std::swap(m_size, right.m_size);
+    m_pixels.swap(right.m_pixels);
 }
 
 } // namespace sf
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RecordingRenderTarget.hpp>
+#include <SFML/Graphics/RenderBackendRecorder.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RecordingRenderTarget::RecordingRenderTarget(unsigned int width, unsigned int height) :
+RenderTarget(new priv::RenderBackendRecorder),
+m_size      (width, height),
+m_recorder  (static_cast<priv::RenderBackendRecorder*>(getRenderBackend()))
+{
+    RenderTarget::initialize();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u RecordingRenderTarget::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const RecordingRenderTarget::Counters& RecordingRenderTarget::getCounters() const
+{
+    return m_recorder->getCounters();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<RecordingRenderTarget::DrawCall>& RecordingRenderTarget::getDrawCalls() const
+{
+    return m_recorder->getDrawCalls();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Vertex>& RecordingRenderTarget::getVertices() const
+{
+    return m_recorder->getVertices();
+}
+
+
+////////////////////////////////////////////////////////////
+void RecordingRenderTarget::clearRecording()
+{
+    m_recorder->clearRecording();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RecordingRenderTarget::activate(bool)
+{
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERBACKEND_HPP
+#define SFML_RENDERBACKEND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class Shader;
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for the low-level rendering
+///        commands issued by render targets
+///
+////////////////////////////////////////////////////////////
+class RenderBackend : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~RenderBackend();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the color buffer of the target
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void clear(const Color& color) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the persistent states needed for drawing
+    ///
+    /// The blending mode, transform, texture and view are
+    /// applied separately by the render target.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void resetStates() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the current states and matrices
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void pushStates() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the states and matrices saved by pushStates
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void popStates() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the viewport and the projection matrix
+    ///
+    /// \param viewport   Viewport, in pixels, with the origin at the bottom-left corner
+    /// \param projection Projection matrix of the view
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setView(const IntRect& viewport, const Transform& projection) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the blending mode
+    ///
+    /// \param mode Blending mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setBlendMode(BlendMode mode) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the model-view matrix
+    ///
+    /// \param transform Transform to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setTransform(const Transform& transform) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a texture, with coordinates in pixels
+    ///
+    /// \param texture Texture to bind, or null to use no texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setTexture(const Texture* texture) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a shader
+    ///
+    /// \param shader Shader to bind, or null to use no shader
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setShader(const Shader* shader) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the array of vertices used by the next draws
+    ///
+    /// The array must remain valid until the next call, its
+    /// content may change between two draws.
+    ///
+    /// \param vertices Pointer to the first vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setVertices(const Vertex* vertices) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives from the current array of vertices
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param vertexCount Number of vertices to draw, from the start of the array
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawPrimitives(PrimitiveType type, unsigned int vertexCount) = 0;
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERBACKEND_HPP
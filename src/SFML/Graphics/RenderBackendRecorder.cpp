@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderBackendRecorder.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RenderBackendRecorder::RenderBackendRecorder() :
+m_counters        (),
+m_drawCalls       (),
+m_recordedVertices(),
+m_vertices        (NULL),
+m_transform       (),
+m_blendMode       (BlendAlpha),
+m_texture         (NULL),
+m_shader          (NULL)
+{
+    clearRecording();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::clear(const Color&)
+{
+    m_counters.clears++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::resetStates()
+{
+    m_shader = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::pushStates()
+{
+    // Nothing to save, the render target applies its own states after pushing
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::popStates()
+{
+    // Nothing to restore
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::setView(const IntRect&, const Transform&)
+{
+    m_counters.viewChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::setBlendMode(BlendMode mode)
+{
+    m_blendMode = mode;
+    m_counters.blendModeChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::setTransform(const Transform& transform)
+{
+    m_transform = transform;
+    m_counters.transformChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+    m_counters.textureChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::setShader(const Shader* shader)
+{
+    m_shader = shader;
+    m_counters.shaderChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::setVertices(const Vertex* vertices)
+{
+    m_vertices = vertices;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::drawPrimitives(PrimitiveType type, unsigned int vertexCount)
+{
+    RecordingRenderTarget::DrawCall drawCall;
+    drawCall.type = type;
+    drawCall.firstVertex = static_cast<unsigned int>(m_recordedVertices.size());
+    drawCall.vertexCount = vertexCount;
+    drawCall.texture = m_texture;
+    drawCall.shader = m_shader;
+    drawCall.blendMode = m_blendMode;
+    m_drawCalls.push_back(drawCall);
+
+    // Store the vertices in world coordinates, like the graphics card would see them
+    m_recordedVertices.resize(m_recordedVertices.size() + vertexCount);
+    m_transform.transformPoints(m_vertices, &m_recordedVertices[drawCall.firstVertex], vertexCount);
+
+    m_counters.drawCalls++;
+    m_counters.vertexCount += vertexCount;
+}
+
+
+////////////////////////////////////////////////////////////
+const RecordingRenderTarget::Counters& RenderBackendRecorder::getCounters() const
+{
+    return m_counters;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<RecordingRenderTarget::DrawCall>& RenderBackendRecorder::getDrawCalls() const
+{
+    return m_drawCalls;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Vertex>& RenderBackendRecorder::getVertices() const
+{
+    return m_recordedVertices;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderBackendRecorder::clearRecording()
+{
+    m_counters.drawCalls = 0;
+    m_counters.vertexCount = 0;
+    m_counters.clears = 0;
+    m_counters.viewChanges = 0;
+    m_counters.transformChanges = 0;
+    m_counters.blendModeChanges = 0;
+    m_counters.textureChanges = 0;
+    m_counters.shaderChanges = 0;
+    m_drawCalls.clear();
+    m_recordedVertices.clear();
+}
+
+} // namespace priv
+
+} // namespace sf
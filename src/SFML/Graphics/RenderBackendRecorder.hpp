@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERBACKENDRECORDER_HPP
+#define SFML_RENDERBACKENDRECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderBackend.hpp>
+#include <SFML/Graphics/RecordingRenderTarget.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Specialization of RenderBackend which records the
+///        commands and their vertices, without rendering
+///
+////////////////////////////////////////////////////////////
+class RenderBackendRecorder : public RenderBackend
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderBackendRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a clear
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void clear(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the current states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void resetStates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the current states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void pushStates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the states saved by pushStates
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void popStates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a view change
+    ///
+    /// \param viewport   Viewport, in pixels, with the origin at the bottom-left corner
+    /// \param projection Projection matrix of the view
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setView(const IntRect& viewport, const Transform& projection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a blending mode change
+    ///
+    /// \param mode Blending mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setBlendMode(BlendMode mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a model-view matrix change
+    ///
+    /// \param transform Transform to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setTransform(const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a texture binding
+    ///
+    /// \param texture Texture to bind, or null to use no texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a shader binding
+    ///
+    /// \param shader Shader to bind, or null to use no shader
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setShader(const Shader* shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the array of vertices used by the next draws
+    ///
+    /// \param vertices Pointer to the first vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setVertices(const Vertex* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw call and copy its vertices
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param vertexCount Number of vertices to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawPrimitives(PrimitiveType type, unsigned int vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the recorded commands
+    ///
+    /// \return Counters of the recorded commands
+    ///
+    ////////////////////////////////////////////////////////////
+    const RecordingRenderTarget::Counters& getCounters() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the recorded draw calls
+    ///
+    /// \return Draw calls, in submission order
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<RecordingRenderTarget::DrawCall>& getDrawCalls() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertices of the recorded draw calls
+    ///
+    /// \return Vertices, in world coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Vertex>& getVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the recorded commands and reset the counters
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearRecording();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RecordingRenderTarget::Counters              m_counters;         ///< Counters of the recorded commands
+    std::vector<RecordingRenderTarget::DrawCall> m_drawCalls;        ///< Recorded draw calls
+    std::vector<Vertex>                          m_recordedVertices; ///< Vertices of the recorded draw calls
+    const Vertex*                                m_vertices;         ///< Current array of vertices
+    Transform                                    m_transform;        ///< Current model-view matrix
+    BlendMode                                    m_blendMode;        ///< Current blending mode
+    const Texture*                               m_texture;          ///< Current texture
+    const Shader*                                m_shader;           ///< Current shader
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERBACKENDRECORDER_HPP
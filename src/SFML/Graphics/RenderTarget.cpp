@@ -30,43 +30,92 @@
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
-#include <SFML/Graphics/GLCheck.hpp>
-#include <SFML/System/Err.hpp>
-#include <iostream>
+#include <SFML/Graphics/RenderBackendGL.hpp>
+#include <SFML/System/Profiler.hpp>
+
+
+namespace
+{
+    // Get the type of primitives that a type is converted to when it is batched
+    sf::PrimitiveType getBatchType(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::Points :
+                return sf::Points;
+
+            case sf::Lines :
+            case sf::LinesStrip :
+                return sf::Lines;
+
+            default :
+                return sf::Triangles;
+        }
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      ()
+m_backend        (new priv::RenderBackendGL),
+m_defaultView    (),
+m_view           (),
+m_cache          (),
+m_batchingEnabled(false),
+m_batch          ()
 {
     m_cache.glStatesSet = false;
+    m_batch.type = Triangles;
+    m_batch.texture = NULL;
+    m_batch.textureId = 0;
+    m_batch.blendMode = BlendAlpha;
+    resetStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::RenderTarget(priv::RenderBackend* backend) :
+m_backend        (backend),
+m_defaultView    (),
+m_view           (),
+m_cache          (),
+m_batchingEnabled(false),
+m_batch          ()
+{
+    m_cache.glStatesSet = false;
+    m_batch.type = Triangles;
+    m_batch.texture = NULL;
+    m_batch.textureId = 0;
+    m_batch.blendMode = BlendAlpha;
+    resetStatistics();
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_backend;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    flush();
+
     if (activate(true))
-    {
-        glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
-        glCheck(glClear(GL_COLOR_BUFFER_BIT));
-    }
+        m_backend->clear(color);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // The pending draws must be rendered with the previous view
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -152,10 +201,103 @@ void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
 void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
                         PrimitiveType type, const RenderStates& states)
 {
+    SFML_PROFILE_ZONE("RenderTarget::draw");
+
     // Nothing to draw?
     if (!vertices || (vertexCount == 0))
         return;
 
+    // Draws with a shader are never batched, as its parameters may change between two draws
+    if (m_batchingEnabled && !states.shader)
+    {
+        // Start a new batch if the states differ from the pending ones
+        PrimitiveType batchType = getBatchType(type);
+        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+        if ((batchType != m_batch.type) || (states.texture != m_batch.texture) ||
+            (textureId != m_batch.textureId) || (states.blendMode != m_batch.blendMode))
+        {
+            flush();
+            m_batch.type = batchType;
+            m_batch.texture = states.texture;
+            m_batch.textureId = textureId;
+            m_batch.blendMode = states.blendMode;
+        }
+
+        appendToBatch(vertices, vertexCount, type, states.transform);
+    }
+    else
+    {
+        // Keep the drawing order
+        flush();
+        drawPrimitives(vertices, vertexCount, type, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batchingEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batchingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_batch.vertices.empty())
+        return;
+
+    // Detach the vertices first, so that the batch is seen empty if
+    // drawing has to reset the states (which flushes the target)
+    std::vector<Vertex> vertices;
+    vertices.swap(m_batch.vertices);
+
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, NULL);
+    drawPrimitives(&vertices[0], static_cast<unsigned int>(vertices.size()), m_batch.type, states);
+
+    // Keep the allocated memory for the next batch
+    vertices.clear();
+    m_batch.vertices.swap(vertices);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flushBeforeRead() const
+{
+    // Sending the pending draws doesn't change the logical contents of the target
+    const_cast<RenderTarget*>(this)->flush();
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetStatistics()
+{
+    m_statistics.drawCalls = 0;
+    m_statistics.vertexCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(const Vertex* vertices, unsigned int vertexCount,
+                                  PrimitiveType type, const RenderStates& states)
+{
     if (activate(true))
     {
         // First set the persistent OpenGL states if it's the very first call
@@ -167,13 +309,7 @@ void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
-            for (unsigned int i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            states.transform.transformPoints(vertices, m_cache.vertexCache, vertexCount);
 
             // Since vertices are transformed, we must use an identity transform to render them
             if (!m_cache.useVertexCache)
@@ -213,20 +349,12 @@ void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
 
         // Setup the pointers to the vertices' components
         if (vertices)
-        {
-            const char* data = reinterpret_cast<const char*>(vertices);
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
-
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
+            m_backend->setVertices(vertices);
 
         // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
+        m_backend->drawPrimitives(type, vertexCount);
+        m_statistics.drawCalls++;
+        m_statistics.vertexCount += vertexCount;
 
         // Unbind the shader, if any
         if (states.shader)
@@ -239,30 +367,85 @@ void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::pushGLStates()
+void RenderTarget::appendToBatch(const Vertex* vertices, unsigned int vertexCount,
+                                 PrimitiveType type, const Transform& transform)
 {
-    if (activate(true))
+    std::vector<Vertex>& batch = m_batch.vertices;
+
+    // Independent primitives can be transformed directly into the batch
+    if ((type == Points) || (type == Lines) || (type == Triangles))
+    {
+        std::size_t first = batch.size();
+        batch.resize(first + vertexCount);
+        transform.transformPoints(vertices, &batch[first], vertexCount);
+        return;
+    }
+
+    // Other primitives are transformed first, then split
+    std::vector<Vertex>& transformed = m_batch.transformed;
+    transformed.resize(vertexCount);
+    transform.transformPoints(vertices, &transformed[0], vertexCount);
+    switch (type)
     {
-#ifdef SFML_DEBUG
-        // make sure that the user didn't leave an unchecked OpenGL error
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR)
+        case LinesStrip :
         {
-            err() << "OpenGL error (" << error << ") detected in user code, "
-                  << "you should check for errors with glGetError()"
-                  << std::endl;
+            for (unsigned int i = 1; i < vertexCount; ++i)
+            {
+                batch.push_back(transformed[i - 1]);
+                batch.push_back(transformed[i]);
+            }
+            break;
         }
-#endif
-
-        glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-        glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+
+        case TrianglesStrip :
+        {
+            for (unsigned int i = 2; i < vertexCount; ++i)
+            {
+                batch.push_back(transformed[i - 2]);
+                batch.push_back(transformed[i - 1]);
+                batch.push_back(transformed[i]);
+            }
+            break;
+        }
+
+        case TrianglesFan :
+        {
+            for (unsigned int i = 2; i < vertexCount; ++i)
+            {
+                batch.push_back(transformed[0]);
+                batch.push_back(transformed[i - 1]);
+                batch.push_back(transformed[i]);
+            }
+            break;
+        }
+
+        case Quads :
+        {
+            for (unsigned int i = 3; i < vertexCount; i += 4)
+            {
+                batch.push_back(transformed[i - 3]);
+                batch.push_back(transformed[i - 2]);
+                batch.push_back(transformed[i - 1]);
+                batch.push_back(transformed[i - 3]);
+                batch.push_back(transformed[i - 1]);
+                batch.push_back(transformed[i]);
+            }
+            break;
+        }
+
+        default :
+            break;
     }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushGLStates()
+{
+    flush();
+
+    if (activate(true))
+        m_backend->pushStates();
 
     resetGLStates();
 }
@@ -271,48 +454,28 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    flush();
+
     if (activate(true))
-    {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        glCheck(glPopClientAttrib());
-        glCheck(glPopAttrib());
-    }
+        m_backend->popStates();
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    flush();
+
     if (activate(true))
     {
-        // Make sure that GLEW is initialized
-        priv::ensureGlewInit();
-
-        // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-        glCheck(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
+        // Define the default OpenGL states (this also unbinds the shader, if any)
+        m_backend->resetStates();
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
         applyTexture(NULL);
-        if (Shader::isAvailable())
-            applyShader(NULL);
         m_cache.useVertexCache = false;
 
         // Set the default view
@@ -321,6 +484,13 @@ void RenderTarget::resetGLStates()
 }
 
 
+////////////////////////////////////////////////////////////
+priv::RenderBackend* RenderTarget::getRenderBackend() const
+{
+    return m_backend;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
@@ -336,17 +506,10 @@ void RenderTarget::initialize()
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
-    // Set the viewport
+    // Set the viewport (with the origin at the bottom-left corner) and the projection matrix
     IntRect viewport = getViewport(m_view);
-    int top = getSize().y - (viewport.top + viewport.height);
-    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
-
-    // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
-
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+    viewport.top = getSize().y - (viewport.top + viewport.height);
+    m_backend->setView(viewport, m_view.getTransform());
 
     m_cache.viewChanged = false;
 }
@@ -355,38 +518,7 @@ void RenderTarget::applyCurrentView()
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyBlendMode(BlendMode mode)
 {
-    switch (mode)
-    {
-        // glBlendFuncSeparateEXT is used when available to avoid an incorrect alpha value when the target
-        // is a RenderTexture -- in this case the alpha value must be written directly to the target buffer
-
-        // Alpha blending
-        default :
-        case BlendAlpha :
-            if (GLEW_EXT_blend_func_separate)
-                glCheck(glBlendFuncSeparateEXT(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
-            else
-                glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-            break;
-
-        // Additive blending
-        case BlendAdd :
-            if (GLEW_EXT_blend_func_separate)
-                glCheck(glBlendFuncSeparateEXT(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ONE));
-            else
-                glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE));
-            break;
-
-        // Multiplicative blending
-        case BlendMultiply :
-            glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
-            break;
-
-        // No blending
-        case BlendNone :
-            glCheck(glBlendFunc(GL_ONE, GL_ZERO));
-            break;
-    }
+    m_backend->setBlendMode(mode);
 
     m_cache.lastBlendMode = mode;
 }
@@ -395,16 +527,14 @@ void RenderTarget::applyBlendMode(BlendMode mode)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
-    // No need to call glMatrixMode(GL_MODELVIEW), it is always the
-    // current mode (for optimization purpose, since it's the most used)
-    glCheck(glLoadMatrixf(transform.getMatrix()));
+    m_backend->setTransform(transform);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    m_backend->setTexture(texture);
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
 }
@@ -413,7 +543,7 @@ void RenderTarget::applyTexture(const Texture* texture)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
-    Shader::bind(shader);
+    m_backend->setShader(shader);
 }
 
 } // namespace sf
@@ -123,6 +123,9 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Render the pending batched draws
+    flush();
+
     // Update the target texture
     if (setActive(true))
     {
@@ -78,6 +78,9 @@ Vector2u RenderWindow::getSize() const
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // The pending batched draws must be in the framebuffer
+    flushBeforeRead();
+
     Image image;
     if (setActive())
     {
@@ -114,4 +117,12 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Render the pending batched draws
+    flush();
+}
+
 } // namespace sf
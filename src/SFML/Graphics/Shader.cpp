@@ -341,7 +341,11 @@ void Shader::setParameter(const std::string& name, const sf::Transform& transfor
         // Get parameter location and assign it new values
         GLint location = getParamLocation(name);
         if (location != -1)
-            glCheck(glUniformMatrix4fvARB(location, 1, GL_FALSE, transform.getMatrix()));
+        {
+            float matrix[16];
+            transform.getMatrix(matrix);
+            glCheck(glUniformMatrix4fvARB(location, 1, GL_FALSE, matrix));
+        }
 
         // Disable program
         glCheck(glUseProgramObjectARB(program));
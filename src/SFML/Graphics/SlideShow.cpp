@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics.hpp>
+#include <SFML/Graphics/GifDecoder.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/Err.hpp>
@@ -54,6 +55,13 @@ SlideShow::~SlideShow()
 
 void SlideShow::deleteSlides()
 {
+    // Give the parked content back to the slide show before releasing the slides
+    if(currentSlide >= 0)
+    {
+        swap(*slides[currentSlide]);
+        currentSlide = -1;
+    }
+
     if(slides.size() > 0)
     {
         for ( it = slides.begin(); it != slides.end() ; it++ )
@@ -68,36 +76,28 @@ void SlideShow::deleteSlides()
 
 bool SlideShow::setCurrentSlide(const unsigned int index)
 {
-    int count = 0;
+    if(index >= slides.size())
+        return false;
 
-    if(slides.size() > index)
-    {
-        for ( it = slides.begin(); it != slides.end(); it++ )
-        {
-            if(count == index)
-            {
-                sf::Vector2u vs = (*it)->getSize();
-                create(vs.x, vs.y, sf::Color::Black);
-                for(int y = 0; y < vs.y; y++)
-                {
-                    for(int x = 0; x < vs.x; x++)
-                    {
-                        setPixel(x,y,(*it)->getPixel(x,y));
-                    }
-                }
-                break;
-            }
-            else
-            {
-                count++;
-            }
-        }
-    }
-
-    if(count == index)
+    if(currentSlide == static_cast<int>(index))
         return true;
 
-    return false;
+    // The active slide lives in this image while the slide object holds
+    // what was here before, so switching is two buffer swaps and no copy
+    if(currentSlide >= 0)
+        swap(*slides[currentSlide]);
+
+    swap(*slides[index]);
+    currentSlide = index;
+
+    return true;
+}
+
+
+
+int SlideShow::getCurrentSlide()const
+{
+    return currentSlide;
 }
 
 
@@ -153,6 +153,36 @@ bool SlideShow::loadSlideFromImage(sf::Image* image)
 
 
 bool SlideShow::loadSlidesFromGifFile(const std::string& filename)
+{
+    GifDecoder decoder;
+    if (!decoder.openFromFile(filename))
+        return false;
+
+    return loadSlidesFromGif(decoder);
+}
+
+
+bool SlideShow::loadSlidesFromGifMemory(const void* data, std::size_t size)
+{
+    GifDecoder decoder;
+    if (!decoder.openFromMemory(data, size))
+        return false;
+
+    return loadSlidesFromGif(decoder);
+}
+
+
+bool SlideShow::loadSlidesFromGifStream(InputStream& stream)
+{
+    GifDecoder decoder;
+    if (!decoder.openFromStream(stream))
+        return false;
+
+    return loadSlidesFromGif(decoder);
+}
+
+
+bool SlideShow::loadSlidesFromGif(GifDecoder& decoder)
 {
     if(sdisposal){
         free(sdisposal);
@@ -162,38 +192,25 @@ bool SlideShow::loadSlidesFromGifFile(const std::string& filename)
     if(getSlideCount())
         deleteSlides();
 
-    int tmp[1000];//sdisposal buffer
-    sf::GifReader gr;
-    int x=0;//return value from GetImageByIndex
-    int counter=0;//current frame index
-
-
-    do
+    // Every frame is decoded once, in file order
+    std::vector<int> disposals;
+    sf::Image* i = new sf::Image;
+    while (decoder.readNextFrame(*i))
     {
-        sf::Image* i = new sf::Image;
-        tmp[counter] = gr.GetImageByIndex(*i, x, filename);
-
-        if(counter && !x)//only if x==0 and counter!=0
-        {
-            delete(i);
-            tmp[counter] = -1;
-            break;
-        }
-
         loadSlideFromImage(i);
+        disposals.push_back(decoder.getFrameDisposal());
+        i = new sf::Image;
+    }
+    delete(i);
 
-        x++;
-        counter++;
-    }while(true);
-
+    if (disposals.empty())
+        return false;
 
-    if ((sdisposal = (int *) malloc((counter-1) * 4)) == NULL)
-        exit(4);
+    if ((sdisposal = (int *) malloc(disposals.size() * sizeof(int))) == NULL)
+        return false;
 
-    for(x=0; x<counter-1; x++)
-    {
-        sdisposal[x] = tmp[x];
-    }
+    std::copy(disposals.begin(), disposals.end(), sdisposal);
+    totalSlides = static_cast<int>(disposals.size());
 
     return true;
 }
@@ -28,7 +28,24 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 #include <cassert>
+#include <limits>
+
+
+namespace
+{
+    // Check whether two transforms are identical
+    bool isSameTransform(const sf::Transform& left, const sf::Transform& right)
+    {
+        float leftMatrix[16];
+        float rightMatrix[16];
+        left.getMatrix(leftMatrix);
+        right.getMatrix(rightMatrix);
+
+        return std::equal(leftMatrix, leftMatrix + 16, rightMatrix);
+    }
+}
 
 
 namespace sf
@@ -50,6 +67,11 @@ m_bounds       ()
     m_numBoundChars=0;
     m_boundMargin=0;
     m_isBounded=false;
+    m_atlasRevision=0;
+    m_geometryNeedUpdate=true;
+    m_validLength=0;
+    m_validSuffix=0;
+    m_layoutLength=0;
 }
 
 
@@ -71,7 +93,11 @@ m_bounds       ()
     m_numBoundChars=0;
     m_boundMargin=0;
     m_isBounded=false;
-    updateGeometry();
+    m_atlasRevision=0;
+    m_geometryNeedUpdate=true;
+    m_validLength=0;
+    m_validSuffix=0;
+    m_layoutLength=0;
 }
 
 
@@ -79,11 +105,23 @@ m_bounds       ()
 ////////////////////////////////////////////////////////////
 void Text::setString(const String& string)
 {
+    // Keep the geometry of the characters that didn't change
+    std::size_t length = std::min(m_validLength, std::min(m_string.getSize(), string.getSize()));
+    const Uint32* previous = m_string.getData();
+    std::size_t common = std::mismatch(previous, previous + length, string.getData()).first - previous;
+
+    // The characters after the edit keep their geometry too, it only has to be moved
+    std::size_t suffixLength = std::min(m_validSuffix, std::min(m_string.getSize(), string.getSize()));
+    const Uint32* previousEnd = previous + m_string.getSize();
+    const Uint32* currentEnd = string.getData() + string.getSize();
+    std::size_t suffix = 0;
+    while ((suffix < suffixLength) && (*(previousEnd - 1 - suffix) == *(currentEnd - 1 - suffix)))
+        ++suffix;
+
     m_string = string;
-    if(m_isBounded)
-        updateGeometryBounding();
-    else
-    	updateGeometry();
+    m_validLength = common;
+    m_validSuffix = suffix;
+    m_geometryNeedUpdate = true;
 }
 
 
@@ -91,17 +129,24 @@ void Text::setString(const String& string)
 void Text::setBoundingMargin(int margin)
 {
 	m_boundMargin = margin;
-    if(m_isBounded)
-        updateGeometryBounding();
-    else
-    	updateGeometry();
+    m_geometryNeedUpdate = true;
+    m_validLength = 0;
+    m_validSuffix = 0;
+    updateBoundingPosition();
 }
 
 
 ////////////////////////////////////////////////////////////
 void Text::setBounding(bool bounding)
 {
-	m_isBounded = bounding;
+    if (m_isBounded != bounding)
+    {
+        m_isBounded = bounding;
+        m_geometryNeedUpdate = true;
+        m_validLength = 0;
+        m_validSuffix = 0;
+        updateBoundingPosition();
+    }
 }
 
 
@@ -111,10 +156,9 @@ void Text::setFont(const Font& font)
     if (m_font != &font)
     {
         m_font = &font;
-        if(m_isBounded)
-            updateGeometryBounding();
-        else
-        	updateGeometry();
+        m_geometryNeedUpdate = true;
+        m_validLength = 0;
+        m_validSuffix = 0;
     }
 }
 
@@ -125,10 +169,9 @@ void Text::setCharacterSize(unsigned int size)
     if (m_characterSize != size)
     {
         m_characterSize = size;
-        if(m_isBounded)
-            updateGeometryBounding();
-        else
-            updateGeometry();
+        m_geometryNeedUpdate = true;
+        m_validLength = 0;
+        m_validSuffix = 0;
     }
 }
 
@@ -139,10 +182,9 @@ void Text::setStyle(Uint32 style)
     if (m_style != style)
     {
         m_style = style;
-        if(m_isBounded)
-            updateGeometryBounding();
-        else
-            updateGeometry();
+        m_geometryNeedUpdate = true;
+        m_validLength = 0;
+        m_validSuffix = 0;
     }
 }
 
@@ -153,6 +195,8 @@ void Text::setColor(const Color& color)
     if (color != m_color)
     {
         m_color = color;
+
+        // Vertices that are rebuilt later will get the new color anyway
         for (unsigned int i = 0; i < m_vertices.getVertexCount(); ++i)
             m_vertices[i].color = m_color;
     }
@@ -162,8 +206,10 @@ void Text::setColor(const Color& color)
 ////////////////////////////////////////////////////////////
 void Text::setBoundingBox(const FloatRect rect){
     m_boundBox = rect;
-    if(m_isBounded)
-        updateGeometryBounding();
+    m_geometryNeedUpdate = true;
+    m_validLength = 0;
+    m_validSuffix = 0;
+    updateBoundingPosition();
 }
 
 
@@ -191,6 +237,7 @@ unsigned int Text::getCharacterSize() const
 ////////////////////////////////////////////////////////////
 unsigned int Text::getNumberBoundedCharacters() const
 {
+    ensureGeometryUpdate();
 	return m_numBoundChars;
 }
 
@@ -216,49 +263,82 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
+    // The positions of the characters are computed along with the geometry
+    ensureGeometryUpdate();
+    if (m_positions.empty())
+        return getTransform().transformPoint(Vector2f());
+
     // Adjust the index if it's out of range
-    if (index > m_string.getSize())
-        index = m_string.getSize();
+    if (index >= m_positions.size())
+        index = m_positions.size() - 1;
 
-    // Precompute the variables needed by the algorithm
-    bool  bold   = (m_style & Bold) != 0;
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+    // The pen is on the baseline, the returned position is at the top of the line
+    Vector2f position = m_positions[index];
+    position.y -= static_cast<float>(m_characterSize);
 
-    // Compute the position
-    Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
-    {
-        Uint32 curChar = m_string[i];
+    // Transform the position to global coordinates
+    position = getTransform().transformPoint(position);
 
-        // Apply the kerning offset
-        position.x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
-        prevChar = curChar;
+    return position;
+}
 
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ' :  position.x += hspace;                 continue;
-            case '\t' : position.x += hspace * 4;             continue;
-            case '\n' : position.y += vspace; position.x = 0; continue;
-            case '\v' : position.y += vspace * 4;             continue;
-        }
 
-        // For regular characters, add the advance offset of the glyph
-        position.x += static_cast<float>(m_font->getGlyph(curChar, m_characterSize, bold).advance);
-    }
+////////////////////////////////////////////////////////////
+std::size_t Text::findCharacterIndex(const Vector2f& point) const
+{
+    // Make sure that we have a valid font
+    if (!m_font)
+        return 0;
 
-    // Transform the position to global coordinates
-    position = getTransform().transformPoint(position);
+    ensureGeometryUpdate();
+    if (m_positions.empty() || m_lines.empty())
+        return 0;
 
-    return position;
+    // Transform the point to local coordinates, on the baseline of its line
+    Vector2f local = getInverseTransform().transformPoint(point);
+    float baseline = local.y + static_cast<float>(m_characterSize);
+
+    // Find the last line that starts above the point
+    std::size_t low = 0;
+    std::size_t high = m_lines.size();
+    while (low < high)
+    {
+        std::size_t middle = (low + high) / 2;
+        if (m_lines[middle].position.y <= baseline)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    std::size_t line = (low > 0) ? low - 1 : 0;
+
+    // Its characters end with the line break (or the wrapped character), or with the text
+    std::size_t first = m_lines[line].index;
+    std::size_t last = (line + 1 < m_lines.size()) ? m_lines[line + 1].index - 1 : m_positions.size() - 1;
+    if (last < first)
+        last = first;
+
+    // Find the first character on the right of the point, then keep the closest of it and its predecessor
+    low = first;
+    high = last;
+    while (low < high)
+    {
+        std::size_t middle = (low + high) / 2;
+        if (m_positions[middle].x <= local.x)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if ((low > first) && (local.x - m_positions[low - 1].x < m_positions[low].x - local.x))
+        --low;
+
+    return low;
 }
 
 
 ////////////////////////////////////////////////////////////
 FloatRect Text::getLocalBounds() const
 {
+    ensureGeometryUpdate();
     return m_bounds;
 }
 
@@ -266,7 +346,8 @@ FloatRect Text::getLocalBounds() const
 ////////////////////////////////////////////////////////////
 FloatRect Text::getGlobalBounds() const
 {
-    return getTransform().transformRect(getLocalBounds());
+    FloatRect bounds = getLocalBounds();
+    return getTransform().transformRect(bounds);
 }
 
 
@@ -282,6 +363,8 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 {
     if (m_font)
     {
+        ensureGeometryUpdate();
+
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
         target.draw(m_vertices, states);
@@ -290,19 +373,79 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 
 
 ////////////////////////////////////////////////////////////
-void Text::updateGeometry()
+void Text::ensureGeometryUpdate() const
 {
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = FloatRect();
+    // Loading the glyphs of the text may make the font repack its atlas; the glyphs used
+    // in the current frame don't move, but the layout is done again so that it matches
+    // the final atlas (the second pass loads nothing new, so it doesn't repack it)
+    for (;;)
+    {
+        // The font moved glyphs within its texture since the geometry was computed
+        if (m_font && (m_font->getAtlasRevision(m_characterSize) != m_atlasRevision))
+        {
+            m_geometryNeedUpdate = true;
+            m_validLength = 0;
+            m_validSuffix = 0;
+        }
+
+        if (!m_geometryNeedUpdate)
+            break;
+
+        if (m_isBounded && m_font)
+            updateGeometryBounding();
+        else
+            updateGeometry();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateBoundingPosition()
+{
+    // The text starts at the top-left corner of the bounding box
+    if (m_isBounded)
+        setPosition(m_boundBox.left + getEffectiveMargin(), m_boundBox.top + getEffectiveMargin());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Text::getEffectiveMargin() const
+{
+    // Margins which leave no room for the text are ignored
+    if ((m_boundMargin >= m_boundBox.width / 2) || (m_boundMargin >= m_boundBox.height / 2))
+        return 0;
+
+    return m_boundMargin;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateGeometry() const
+{
+    m_geometryNeedUpdate = false;
 
     // No font: nothing to draw
     if (!m_font)
+    {
+        m_vertices.clear();
+        m_bounds = FloatRect();
+        m_lines.clear();
+        m_positions.clear();
         return;
+    }
+
+    // Glyphs loaded below may move the other ones, in which case the geometry will be rebuilt when drawn
+    m_atlasRevision = m_font->getAtlasRevision(m_characterSize);
 
     // No text: nothing to draw
     if (m_string.isEmpty())
+    {
+        m_vertices.clear();
+        m_bounds = FloatRect();
+        m_lines.clear();
+        m_positions.clear();
         return;
+    }
 
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
@@ -314,18 +457,49 @@ void Text::updateGeometry()
     // Precompute the variables needed by the algorithm
     float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
     float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
 
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    // The lines made of the characters after the edit only move, keep them aside until the layout reaches them
+    std::size_t kept = m_lines.size();
+    while ((kept > 1) && (m_lines[kept - 1].index > m_validLength) && (m_lines[kept - 1].index + m_validSuffix > m_layoutLength))
+        --kept;
+    std::vector<LineState> tail(m_lines.begin() + kept, m_lines.end());
+    std::vector<Vertex> tailVertices;
+    std::vector<Vector2f> tailPositions;
+    if (!tail.empty())
+    {
+        if (tail.front().vertices < m_vertices.getVertexCount())
+            tailVertices.assign(&m_vertices[tail.front().vertices], &m_vertices[0] + m_vertices.getVertexCount());
+        tailPositions.assign(m_positions.begin() + tail.front().index, m_positions.end());
+    }
+    std::size_t next = 0;
+    bool moved = false;
+
+    // Resume from the start of the last line whose previous characters didn't change
+    float none = std::numeric_limits<float>::max();
+    if (m_validLength == 0)
+    {
+        m_lines.clear();
+        m_lines.push_back(LineState(0, 0, Vector2f(0.f, static_cast<float>(m_characterSize)), Vector2f(), none, none, -none, -none));
+    }
+    while (m_lines.back().index > m_validLength)
+        m_lines.pop_back();
+    LineState line = m_lines.back();
+    m_vertices.resize(line.vertices);
+    m_positions.resize(line.index);
+
+    float x = line.position.x;
+    float y = line.position.y;
+
+    // Create one quad for each character, and compute the bounds of each line
+    float minX = none;
+    float minY = none;
+    float maxX = -none;
+    float maxY = -none;
+    Uint32 prevChar = (line.index > 0) ? m_string[line.index - 1] : 0;
+    for (std::size_t i = line.index; i < m_string.getSize(); ++i)
     {
         Uint32 curChar = m_string[i];
+        m_positions.push_back(Vector2f(x, y));
 
         // Apply the kerning offset
         x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
@@ -362,6 +536,30 @@ void Text::updateGeometry()
             maxX = std::max(maxX, x);
             maxY = std::max(maxY, y);
 
+            // Remember where the next line starts
+            if (curChar == '\n')
+            {
+                m_lines.back().minX = minX;
+                m_lines.back().minY = minY;
+                m_lines.back().maxX = maxX;
+                m_lines.back().maxY = maxY;
+                m_lines.push_back(LineState(i + 1, m_vertices.getVertexCount(), Vector2f(0.f, y), Vector2f(), none, none, -none, -none));
+                minX = none;
+                minY = none;
+                maxX = -none;
+                maxY = -none;
+
+                // The next lines didn't change, move them instead of laying them out again
+                while ((next < tail.size()) && (tail[next].index + m_string.getSize() < i + 1 + m_layoutLength))
+                    ++next;
+                if ((next < tail.size()) && (tail[next].index + m_string.getSize() == i + 1 + m_layoutLength))
+                {
+                    moveLines(tail, next, tail.size(), tailVertices, tailPositions);
+                    moved = true;
+                    break;
+                }
+            }
+
             // Next glyph, no need to create a quad for whitespace
             continue;
         }
@@ -395,57 +593,90 @@ void Text::updateGeometry()
         x += glyph.advance;
     }
 
-    // If we're using the underlined style, add the last line
-    if (underlined)
+    // The moved lines already end the text
+    if (!moved)
     {
-        float top = y + underlineOffset;
-        float bottom = top + underlineThickness;
+        // If we're using the underlined style, add the last line
+        if (underlined)
+        {
+            float top = y + underlineOffset;
+            float bottom = top + underlineThickness;
 
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
+            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
+            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
+            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
+        }
+
+        // The position after the last character is the end of the text
+        m_positions.push_back(Vector2f(x, y));
+
+        m_lines.back().minX = minX;
+        m_lines.back().minY = minY;
+        m_lines.back().maxX = maxX;
+        m_lines.back().maxY = maxY;
     }
 
     // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+    float size = static_cast<float>(m_characterSize);
+    float left = size;
+    float top = size;
+    float right = 0.f;
+    float bottom = 0.f;
+    for (std::vector<LineState>::const_iterator it = m_lines.begin(); it != m_lines.end(); ++it)
+    {
+        left = std::min(left, it->minX);
+        top = std::min(top, it->minY);
+        right = std::max(right, it->maxX);
+        bottom = std::max(bottom, it->maxY);
+    }
+    m_bounds.left = left;
+    m_bounds.top = top;
+    m_bounds.width = right - left;
+    m_bounds.height = bottom - top;
+
+    m_validLength = m_string.getSize();
+    m_validSuffix = m_string.getSize();
+    m_layoutLength = m_string.getSize();
 }
 
 
 ////////////////////////////////////////////////////////////
-void Text::updateGeometryBounding()
+void Text::updateGeometryBounding() const
 {
     assert(m_font != NULL);
 
-    //realign position to bounding box
-    setPosition(m_boundBox.left + m_boundMargin, m_boundBox.top + m_boundMargin);
+    // The layout is computed here, until the next change
+    m_geometryNeedUpdate = false;
 
-    //reset number of bounded characters
-    m_numBoundChars = 0;
+    // Lines are wrapped in global coordinates, they can't be reused if the transform changed
+    if (!isSameTransform(getTransform(), m_layoutTransform))
+    {
+        m_validLength = 0;
+        m_validSuffix = 0;
+    }
+    m_layoutTransform = getTransform();
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = sf::FloatRect();
+    // Glyphs loaded below may move the other ones, in which case the geometry will be rebuilt when drawn
+    m_atlasRevision = m_font->getAtlasRevision(m_characterSize);
 
     // No text: nothing to draw
     if (m_string.isEmpty())
+    {
+        m_vertices.clear();
+        m_bounds = sf::FloatRect();
+        m_lines.clear();
+        m_positions.clear();
+        m_numBoundChars = 0;
         return;
-
-    //correct margins
-    if(m_boundMargin >= m_boundBox.width/2 || m_boundMargin >= m_boundBox.height/2)
-    	m_boundMargin = 0;
+    }
 
     //Bounding Data
+    unsigned int boundMargin = getEffectiveMargin();
     float boundTop = m_boundBox.top;
     float boundLeft = m_boundBox.left;
     float boundHeight = m_boundBox.height;
     float boundWidth = m_boundBox.width;
-    Vector2f position;
-    Vector2f positionGlobal;
-    unsigned int charCounter = 0;//current character in m_string
 
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
@@ -457,15 +688,57 @@ void Text::updateGeometryBounding()
     // Precompute the variables needed by the algorithm
     float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
     float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    position.x      = 0.f;
-    position.y      = static_cast<float>(m_characterSize);
+
+    // The lines made of the characters after the edit only move, keep them aside until the layout
+    // reaches them; this requires a transform which doesn't mix the axes, so that they wrap the same
+    Vector2f origin = getTransform().transformPoint(0.f, 0.f);
+    Vector2f horizontal = getTransform().transformPoint(1.f, 0.f) - origin;
+    Vector2f vertical = getTransform().transformPoint(0.f, 1.f) - origin;
+    std::size_t kept = m_lines.size();
+    if ((horizontal.y == 0.f) && (vertical.x == 0.f) && (vertical.y > 0.f))
+    {
+        while ((kept > 1) && (m_lines[kept - 1].index >= m_validLength) && (m_lines[kept - 1].index + m_validSuffix > m_layoutLength))
+            --kept;
+    }
+    std::vector<LineState> tail(m_lines.begin() + kept, m_lines.end());
+    std::vector<Vertex> tailVertices;
+    std::vector<Vector2f> tailPositions;
+    if (!tail.empty())
+    {
+        if (tail.front().vertices < m_vertices.getVertexCount())
+            tailVertices.assign(&m_vertices[tail.front().vertices], &m_vertices[0] + m_vertices.getVertexCount());
+        tailPositions.assign(m_positions.begin() + tail.front().index, m_positions.end());
+    }
+    std::size_t next = 0;
+
+    // Resume from the start of the last line whose characters didn't change; unlike
+    // explicit line breaks, a wrapped line depends on its first character
+    if (m_validLength == 0)
+    {
+        m_lines.clear();
+        m_lines.push_back(LineState(0, 0, Vector2f(0.f, static_cast<float>(m_characterSize + boundMargin)), Vector2f(), 0.f, 0.f, 0.f, 0.f));
+    }
+    while ((m_lines.size() > 1) && (m_lines.back().index >= m_validLength))
+        m_lines.pop_back();
+    LineState line = m_lines.back();
+    m_vertices.resize(line.vertices);
+    m_positions.resize(line.index);
+
+    Vector2f position = line.position;
+    Vector2f positionGlobal = line.global;
+    std::size_t charCounter = line.index;//current character in m_string
+    m_numBoundChars = static_cast<unsigned int>(line.index);
+
+    // Position after the last visible character, when the text doesn't fit in the box
+    bool truncated = false;
+    Vector2f end;
 
     // Create one quad for each character
-    Uint32 prevChar = 0;
-    position.y += m_boundMargin;
-    while (positionGlobal.y < boundHeight + boundTop + m_boundMargin && charCounter < m_string.getSize())
+    Uint32 prevChar = (line.index > 0) ? L'\n' : 0;
+    while (positionGlobal.y < boundHeight + boundTop + boundMargin && charCounter < m_string.getSize())
     {
         Uint32 curChar = m_string[charCounter];
+        Vector2f pen = position;
 
         // Apply the kerning offset
         position.x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
@@ -474,7 +747,7 @@ void Text::updateGeometryBounding()
         positionGlobal = getTransform().transformPoint(position);
 
         //correct out of bounds
-        if(curChar != L'\n' && positionGlobal.x >= boundWidth + boundLeft + m_boundMargin + hspace){//check width
+        if(curChar != L'\n' && positionGlobal.x >= boundWidth + boundLeft + boundMargin + hspace){//check width
         	position.x -= static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
         	curChar = L'\n';
         	position.x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
@@ -482,18 +755,22 @@ void Text::updateGeometryBounding()
         else if(curChar == L'\n'){//check height
         	position.y += vspace;
         	positionGlobal = getTransform().transformPoint(position);
-        	if(positionGlobal.y >= boundHeight + boundTop + m_boundMargin){
+        	if(positionGlobal.y >= boundHeight + boundTop + boundMargin){
+        		truncated = true;
+        		end = pen;
         		break;
         	}
         	else{
         		position.y -= vspace;
                 	charCounter++;
                 	m_numBoundChars++;
+                	m_positions.push_back(pen);
         	}
         }
         else{
 		charCounter++;
 		m_numBoundChars++;
+		m_positions.push_back(pen);
         }
 
         prevChar = curChar;
@@ -515,8 +792,34 @@ void Text::updateGeometryBounding()
         {
             case L' ' :  position.x += hspace;        continue;
             case L'\t' : position.x += hspace * 4;    continue;
-            case L'\n' : position.y += vspace; position.x = m_boundBox.left+m_boundMargin; continue;
             case L'\v' : position.y += vspace * 4;    continue;
+            case L'\n' :
+                position.y += vspace;
+                position.x = m_boundBox.left+boundMargin;
+
+                // Remember where the next line starts
+                m_lines.push_back(LineState(charCounter, m_vertices.getVertexCount(), position, positionGlobal, 0.f, 0.f, 0.f, 0.f));
+
+                // The next lines didn't change, move the ones which stay in the box instead of wrapping them again
+                while ((next < tail.size()) && (tail[next].index + m_string.getSize() < charCounter + m_layoutLength))
+                    ++next;
+                if ((next < tail.size()) && (tail[next].index + m_string.getSize() == charCounter + m_layoutLength))
+                {
+                    float offset = position.y - tail[next].position.y;
+                    std::size_t last = next;
+                    while ((last + 1 < tail.size()) &&
+                           (getTransform().transformPoint(tail[last + 1].position.x, tail[last + 1].position.y + offset).y < boundHeight + boundTop + boundMargin))
+                        ++last;
+                    moveLines(tail, next, last, tailVertices, tailPositions);
+                    next = tail.size();
+
+                    // Continue with the first line which may not fit
+                    position = m_lines.back().position;
+                    positionGlobal = m_lines.back().global;
+                    charCounter = m_lines.back().index;
+                    m_numBoundChars = static_cast<unsigned int>(charCounter);
+                }
+                continue;
         }
 
 
@@ -545,6 +848,9 @@ void Text::updateGeometryBounding()
         positionGlobal = getTransform().transformPoint(position);
     }
 
+    // The position after the last visible character is the end of the text
+    m_positions.push_back(truncated ? end : position);
+
     // If we're using the underlined style, add the last line
     if (underlined)
     {
@@ -559,6 +865,56 @@ void Text::updateGeometryBounding()
 
     // Recompute the bounding rectangle
     m_bounds = m_vertices.getBounds();
+
+    m_validLength = m_numBoundChars;
+    m_validSuffix = m_string.getSize();
+    m_layoutLength = m_string.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::moveLines(const std::vector<LineState>& lines, std::size_t first, std::size_t last,
+                     const std::vector<Vertex>& vertices, const std::vector<Vector2f>& positions) const
+{
+    // The lines keep their layout, only their first character and their vertical position change
+    const LineState& line = lines[first];
+    std::size_t index = m_lines.back().index;
+    unsigned int vertexCount = m_vertices.getVertexCount();
+    float offset = m_lines.back().position.y - line.position.y;
+    Vector2f globalOffset = getTransform().transformPoint(0.f, offset) - getTransform().transformPoint(0.f, 0.f);
+
+    // Copy the vertices and the character positions of the moved lines
+    std::size_t vertexBegin = line.vertices - lines.front().vertices;
+    std::size_t vertexEnd = (last < lines.size()) ? lines[last].vertices - lines.front().vertices : vertices.size();
+    if (vertexEnd > vertexBegin)
+    {
+        m_vertices.resize(static_cast<unsigned int>(vertexCount + vertexEnd - vertexBegin));
+        Vertex* target = &m_vertices[vertexCount];
+        for (std::size_t i = vertexBegin; i < vertexEnd; ++i, ++target)
+        {
+            *target = vertices[i];
+            target->position.y += offset;
+        }
+    }
+    std::size_t positionBegin = line.index - lines.front().index;
+    std::size_t positionEnd = (last < lines.size()) ? lines[last].index - lines.front().index : positions.size();
+    m_positions.resize(index + positionEnd - positionBegin);
+    for (std::size_t i = positionBegin; i < positionEnd; ++i)
+        m_positions[index + i - positionBegin] = Vector2f(positions[i].x, positions[i].y + offset);
+
+    // Then the state at the start of each line, up to the one where the layout resumes
+    m_lines.pop_back();
+    for (std::size_t i = first; (i <= last) && (i < lines.size()); ++i)
+    {
+        LineState moved = lines[i];
+        moved.index = moved.index - line.index + index;
+        moved.vertices = moved.vertices - line.vertices + vertexCount;
+        moved.position.y += offset;
+        moved.global += globalOffset;
+        moved.minY += offset;
+        moved.maxY += offset;
+        m_lines.push_back(moved);
+    }
 }
 
 } // namespace sf
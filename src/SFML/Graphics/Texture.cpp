@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Window.hpp>
@@ -62,6 +63,7 @@ m_texture      (0),
 m_isSmooth     (false),
 m_isRepeated   (false),
 m_pixelsFlipped(false),
+m_isAlphaOnly  (false),
 m_cacheId      (getUniqueId())
 {
 
@@ -76,10 +78,26 @@ m_texture      (0),
 m_isSmooth     (copy.m_isSmooth),
 m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
+m_isAlphaOnly  (false),
 m_cacheId      (getUniqueId())
 {
     if (copy.m_texture)
-        loadFromImage(copy.copyToImage());
+    {
+        if (copy.m_isAlphaOnly)
+        {
+            // Keep the copy in the compact format
+            if (create(copy.m_size.x, copy.m_size.y, true))
+            {
+                std::vector<Uint8> pixels(copy.m_size.x * copy.m_size.y);
+                copy.copyAlpha(&pixels[0]);
+                updateAlpha(&pixels[0], m_size.x, m_size.y, 0, 0);
+            }
+        }
+        else
+        {
+            loadFromImage(copy.copyToImage());
+        }
+    }
 }
 
 
@@ -99,6 +117,13 @@ Texture::~Texture()
 
 ////////////////////////////////////////////////////////////
 bool Texture::create(unsigned int width, unsigned int height)
+{
+    return create(width, height, false);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::create(unsigned int width, unsigned int height, bool alphaOnly)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -121,11 +146,17 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    // Alpha-only textures must be sampled as white, which requires swizzling their color channels
+    if (alphaOnly && !GLEW_ARB_texture_swizzle && !GLEW_EXT_texture_swizzle)
+        alphaOnly = false;
+
     // All the validity checks passed, we can store the new texture settings
+    bool wasAlphaOnly = m_isAlphaOnly;
     m_size.x        = width;
     m_size.y        = height;
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
+    m_isAlphaOnly   = alphaOnly;
 
     ensureGlContext();
 
@@ -142,7 +173,16 @@ bool Texture::create(unsigned int width, unsigned int height)
 
     // Initialize the texture
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    if (m_isAlphaOnly)
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, m_actualSize.x, m_actualSize.y, 0, GL_ALPHA, GL_UNSIGNED_BYTE, NULL));
+    else
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    if (m_isAlphaOnly || wasAlphaOnly)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, m_isAlphaOnly ? GL_ONE : GL_RED));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, m_isAlphaOnly ? GL_ONE : GL_GREEN));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, m_isAlphaOnly ? GL_ONE : GL_BLUE));
+    }
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
@@ -260,46 +300,25 @@ Image Texture::copyToImage() const
 
     ensureGlContext();
 
-    // Make sure that the current texture binding will be preserved
-    priv::TextureSaver save;
-
     // Create an array of pixels
     std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
 
-    if ((m_size == m_actualSize) && !m_pixelsFlipped)
+    if (m_isAlphaOnly)
     {
-        // Texture is not padded nor flipped, we can use a direct copy
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+        // Alpha-only textures are sampled as white, give them the same appearance
+        std::vector<Uint8> alpha(m_size.x * m_size.y);
+        readPixels(&alpha[0], GL_ALPHA, 1);
+        for (std::size_t i = 0; i < alpha.size(); ++i)
+        {
+            pixels[i * 4 + 0] = 255;
+            pixels[i * 4 + 1] = 255;
+            pixels[i * 4 + 2] = 255;
+            pixels[i * 4 + 3] = alpha[i];
+        }
     }
     else
     {
-        // Texture is either padded or flipped, we have to use a slower algorithm
-
-        // All the pixels will first be copied to a temporary array
-        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
-
-        // Then we copy the useful pixels from the temporary array to the final one
-        const Uint8* src = &allPixels[0];
-        Uint8* dst = &pixels[0];
-        int srcPitch = m_actualSize.x * 4;
-        int dstPitch = m_size.x * 4;
-
-        // Handle the case where source pixels are flipped vertically
-        if (m_pixelsFlipped)
-        {
-            src += srcPitch * (m_size.y - 1);
-            srcPitch = -srcPitch;
-        }
-
-        for (unsigned int i = 0; i < m_size.y; ++i)
-        {
-            std::memcpy(dst, src, dstPitch);
-            src += srcPitch;
-            dst += dstPitch;
-        }
+        readPixels(&pixels[0], GL_RGBA, 4);
     }
 
     // Create the image
@@ -340,6 +359,64 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::updateAlpha(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (pixels && m_texture)
+    {
+        if (m_isAlphaOnly)
+        {
+            ensureGlContext();
+
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save;
+
+            // Copy pixels from the given array to the texture (rows are not aligned on 4 bytes)
+            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_ALPHA, GL_UNSIGNED_BYTE, pixels));
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+            m_pixelsFlipped = false;
+            m_cacheId = getUniqueId();
+        }
+        else
+        {
+            // Expand the alpha values to white pixels
+            std::vector<Uint8> rgba(width * height * 4, 255);
+            for (std::size_t i = 0; i < width * height; ++i)
+                rgba[i * 4 + 3] = pixels[i];
+
+            update(&rgba[0], width, height, x, y);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::copyAlpha(Uint8* pixels) const
+{
+    if (!m_texture)
+        return;
+
+    ensureGlContext();
+
+    if (m_isAlphaOnly)
+    {
+        readPixels(pixels, GL_ALPHA, 1);
+    }
+    else
+    {
+        std::vector<Uint8> rgba(m_size.x * m_size.y * 4);
+        readPixels(&rgba[0], GL_RGBA, 4);
+        for (std::size_t i = 0; i < m_size.x * m_size.y; ++i)
+            pixels[i] = rgba[i * 4 + 3];
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image)
 {
@@ -368,6 +445,11 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
+    // If the window is a render window, its pending batched draws must be in the back-buffer
+    const RenderTarget* target = dynamic_cast<const RenderTarget*>(&window);
+    if (target)
+        target->flushBeforeRead();
+
     if (m_texture && window.setActive(true))
     {
         // Make sure that the current texture binding will be preserved
@@ -519,12 +601,61 @@ Texture& Texture::operator =(const Texture& right)
     std::swap(m_isSmooth,      temp.m_isSmooth);
     std::swap(m_isRepeated,    temp.m_isRepeated);
     std::swap(m_pixelsFlipped, temp.m_pixelsFlipped);
+    std::swap(m_isAlphaOnly,   temp.m_isAlphaOnly);
     m_cacheId = getUniqueId();
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::readPixels(Uint8* pixels, unsigned int format, unsigned int channels) const
+{
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Rows of single channel textures are not aligned on 4 bytes
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+
+    if ((m_size == m_actualSize) && !m_pixelsFlipped)
+    {
+        // Texture is not padded nor flipped, we can use a direct copy
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, pixels));
+    }
+    else
+    {
+        // Texture is either padded or flipped, we have to use a slower algorithm
+
+        // All the pixels will first be copied to a temporary array
+        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * channels);
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, &allPixels[0]));
+
+        // Then we copy the useful pixels from the temporary array to the final one
+        const Uint8* src = &allPixels[0];
+        Uint8* dst = pixels;
+        int srcPitch = m_actualSize.x * channels;
+        int dstPitch = m_size.x * channels;
+
+        // Handle the case where source pixels are flipped vertically
+        if (m_pixelsFlipped)
+        {
+            src += srcPitch * (m_size.y - 1);
+            srcPitch = -srcPitch;
+        }
+
+        for (unsigned int i = 0; i < m_size.y; ++i)
+        {
+            std::memcpy(dst, src, dstPitch);
+            src += srcPitch;
+            dst += dstPitch;
+        }
+    }
+
+    glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getValidSize(unsigned int size)
 {
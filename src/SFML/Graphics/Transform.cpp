@@ -26,7 +26,26 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <cmath>
+#include <cstring>
+
+// Select the SIMD instructions used by transformPoints
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_USE_NEON
+#endif
+
+
+namespace
+{
+    // Protects the 4x4 matrices allocated by Transform::getMatrix()
+    sf::Mutex glMatrixMutex;
+}
 
 
 namespace sf
@@ -36,56 +55,77 @@ const Transform Transform::Identity;
 
 
 ////////////////////////////////////////////////////////////
-Transform::Transform()
+Transform::Transform() :
+m_glMatrix(NULL)
 {
     // Identity matrix
-    m_matrix[0] = 1.f; m_matrix[4] = 0.f; m_matrix[8]  = 0.f; m_matrix[12] = 0.f;
-    m_matrix[1] = 0.f; m_matrix[5] = 1.f; m_matrix[9]  = 0.f; m_matrix[13] = 0.f;
-    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
-    m_matrix[3] = 0.f; m_matrix[7] = 0.f; m_matrix[11] = 0.f; m_matrix[15] = 1.f;
+    m_matrix[0] = 1.f; m_matrix[1] = 0.f; m_matrix[2] = 0.f;
+    m_matrix[3] = 0.f; m_matrix[4] = 1.f; m_matrix[5] = 0.f;
 }
 
 
 ////////////////////////////////////////////////////////////
 Transform::Transform(float a00, float a01, float a02,
                      float a10, float a11, float a12,
-                     float a20, float a21, float a22)
+                     float, float, float) :
+m_glMatrix(NULL)
 {
-    m_matrix[0] = a00; m_matrix[4] = a01; m_matrix[8]  = 0.f; m_matrix[12] = a02;
-    m_matrix[1] = a10; m_matrix[5] = a11; m_matrix[9]  = 0.f; m_matrix[13] = a12;
-    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
-    m_matrix[3] = a20; m_matrix[7] = a21; m_matrix[11] = 0.f; m_matrix[15] = a22;
+    m_matrix[0] = a00; m_matrix[1] = a01; m_matrix[2] = a02;
+    m_matrix[3] = a10; m_matrix[4] = a11; m_matrix[5] = a12;
 }
 
 
 ////////////////////////////////////////////////////////////
 const float* Transform::getMatrix() const
 {
-    return m_matrix;
+    float matrix[16];
+    getMatrix(matrix);
+
+    // The shared matrix is only written when it changes, so that threads
+    // which read the matrix of a constant transform (like Identity) never
+    // see it being modified
+    Lock lock(glMatrixMutex);
+    if (!m_glMatrix)
+    {
+        m_glMatrix = new float[16];
+        std::memcpy(m_glMatrix, matrix, sizeof(matrix));
+    }
+    else if (std::memcmp(m_glMatrix, matrix, sizeof(matrix)) != 0)
+    {
+        std::memcpy(m_glMatrix, matrix, sizeof(matrix));
+    }
+
+    return m_glMatrix;
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::getMatrix(float* matrix) const
+{
+    matrix[0] = m_matrix[0]; matrix[4] = m_matrix[1]; matrix[8]  = 0.f; matrix[12] = m_matrix[2];
+    matrix[1] = m_matrix[3]; matrix[5] = m_matrix[4]; matrix[9]  = 0.f; matrix[13] = m_matrix[5];
+    matrix[2] = 0.f;         matrix[6] = 0.f;         matrix[10] = 1.f; matrix[14] = 0.f;
+    matrix[3] = 0.f;         matrix[7] = 0.f;         matrix[11] = 0.f; matrix[15] = 1.f;
 }
 
 
 ////////////////////////////////////////////////////////////
 Transform Transform::getInverse() const
 {
-    // Compute the determinant
-    float det = m_matrix[0] * (m_matrix[15] * m_matrix[5] - m_matrix[7] * m_matrix[13]) -
-                m_matrix[1] * (m_matrix[15] * m_matrix[4] - m_matrix[7] * m_matrix[12]) +
-                m_matrix[3] * (m_matrix[13] * m_matrix[4] - m_matrix[5] * m_matrix[12]);
+    // Compute the determinant of the linear part
+    float det = m_matrix[0] * m_matrix[4] - m_matrix[1] * m_matrix[3];
 
     // Compute the inverse if the determinant is not zero
     // (don't use an epsilon because the determinant may *really* be tiny)
     if (det != 0.f)
     {
-        return Transform( (m_matrix[15] * m_matrix[5] - m_matrix[7] * m_matrix[13]) / det,
-                         -(m_matrix[15] * m_matrix[4] - m_matrix[7] * m_matrix[12]) / det,
-                          (m_matrix[13] * m_matrix[4] - m_matrix[5] * m_matrix[12]) / det,
-                         -(m_matrix[15] * m_matrix[1] - m_matrix[3] * m_matrix[13]) / det,
-                          (m_matrix[15] * m_matrix[0] - m_matrix[3] * m_matrix[12]) / det,
-                         -(m_matrix[13] * m_matrix[0] - m_matrix[1] * m_matrix[12]) / det,
-                          (m_matrix[7]  * m_matrix[1] - m_matrix[3] * m_matrix[5])  / det,
-                         -(m_matrix[7]  * m_matrix[0] - m_matrix[3] * m_matrix[4])  / det,
-                          (m_matrix[5]  * m_matrix[0] - m_matrix[1] * m_matrix[4])  / det);
+        return Transform( m_matrix[4] / det,
+                         -m_matrix[1] / det,
+                          (m_matrix[5] * m_matrix[1] - m_matrix[4] * m_matrix[2]) / det,
+                         -m_matrix[3] / det,
+                          m_matrix[0] / det,
+                          (m_matrix[3] * m_matrix[2] - m_matrix[5] * m_matrix[0]) / det,
+                          0.f, 0.f, 1.f);
     }
     else
     {
@@ -97,8 +137,8 @@ Transform Transform::getInverse() const
 ////////////////////////////////////////////////////////////
 Vector2f Transform::transformPoint(float x, float y) const
 {
-    return Vector2f(m_matrix[0] * x + m_matrix[4] * y + m_matrix[12],
-                    m_matrix[1] * x + m_matrix[5] * y + m_matrix[13]);
+    return Vector2f(m_matrix[0] * x + m_matrix[1] * y + m_matrix[2],
+                    m_matrix[3] * x + m_matrix[4] * y + m_matrix[5]);
 }
 
 
@@ -109,6 +149,73 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vertex* vertices, Vertex* result, std::size_t count) const
+{
+    // Only the 2D affine part of the matrix is used, like in transformPoint
+    std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_USE_SSE2)
+
+    // Two vertices per iteration: [x0 y0 x1 y1] * [a d a d] + [y0 x0 y1 x1] * [b c b c] + [tx ty tx ty]
+    const __m128 diagonal     = _mm_setr_ps(m_matrix[0], m_matrix[4], m_matrix[0], m_matrix[4]);
+    const __m128 antiDiagonal = _mm_setr_ps(m_matrix[1], m_matrix[3], m_matrix[1], m_matrix[3]);
+    const __m128 translation  = _mm_setr_ps(m_matrix[2], m_matrix[5], m_matrix[2], m_matrix[5]);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128 points = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&vertices[i].position));
+        points = _mm_loadh_pi(points, reinterpret_cast<const __m64*>(&vertices[i + 1].position));
+        __m128 swapped = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 3, 0, 1));
+        points = _mm_add_ps(_mm_add_ps(_mm_mul_ps(points, diagonal), _mm_mul_ps(swapped, antiDiagonal)), translation);
+
+        result[i].color         = vertices[i].color;
+        result[i].texCoords     = vertices[i].texCoords;
+        result[i + 1].color     = vertices[i + 1].color;
+        result[i + 1].texCoords = vertices[i + 1].texCoords;
+        _mm_storel_pi(reinterpret_cast<__m64*>(&result[i].position), points);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(&result[i + 1].position), points);
+    }
+
+#elif defined(SFML_TRANSFORM_USE_NEON)
+
+    // Two vertices per iteration, same layout as the SSE2 version
+    const float diagonalValues[]     = {m_matrix[0], m_matrix[4], m_matrix[0], m_matrix[4]};
+    const float antiDiagonalValues[] = {m_matrix[1], m_matrix[3], m_matrix[1], m_matrix[3]};
+    const float translationValues[]  = {m_matrix[2], m_matrix[5], m_matrix[2], m_matrix[5]};
+    const float32x4_t diagonal     = vld1q_f32(diagonalValues);
+    const float32x4_t antiDiagonal = vld1q_f32(antiDiagonalValues);
+    const float32x4_t translation  = vld1q_f32(translationValues);
+    for (; i + 2 <= count; i += 2)
+    {
+        float32x4_t points = vcombine_f32(vld1_f32(&vertices[i].position.x), vld1_f32(&vertices[i + 1].position.x));
+        float32x4_t swapped = vrev64q_f32(points);
+        points = vaddq_f32(vaddq_f32(vmulq_f32(points, diagonal), vmulq_f32(swapped, antiDiagonal)), translation);
+
+        result[i].color         = vertices[i].color;
+        result[i].texCoords     = vertices[i].texCoords;
+        result[i + 1].color     = vertices[i + 1].color;
+        result[i + 1].texCoords = vertices[i + 1].texCoords;
+        vst1_f32(&result[i].position.x, vget_low_f32(points));
+        vst1_f32(&result[i + 1].position.x, vget_high_f32(points));
+    }
+
+#endif
+
+    // Remaining vertices (or all of them, without SIMD instructions)
+    const float a = m_matrix[0], b = m_matrix[1], tx = m_matrix[2];
+    const float c = m_matrix[3], d = m_matrix[4], ty = m_matrix[5];
+    for (; i < count; ++i)
+    {
+        float x = vertices[i].position.x;
+        float y = vertices[i].position.y;
+        result[i].position.x = a * x + b * y + tx;
+        result[i].position.y = c * x + d * y + ty;
+        result[i].color      = vertices[i].color;
+        result[i].texCoords  = vertices[i].texCoords;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
@@ -141,18 +248,17 @@ FloatRect Transform::transformRect(const FloatRect& rectangle) const
 ////////////////////////////////////////////////////////////
 Transform& Transform::combine(const Transform& transform)
 {
+    // Product of two affine matrices; the bottom row stays (0, 0, 1)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
-    *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
-                      a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
-                      a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
-                      a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
-                      a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
-                      a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
-                      a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
-                      a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
-                      a[3] * b[12] + a[7] * b[13] + a[15] * b[15]);
+    float result[6] = {a[0] * b[0] + a[1] * b[3],
+                       a[0] * b[1] + a[1] * b[4],
+                       a[0] * b[2] + a[1] * b[5] + a[2],
+                       a[3] * b[0] + a[4] * b[3],
+                       a[3] * b[1] + a[4] * b[4],
+                       a[3] * b[2] + a[4] * b[5] + a[5]};
+    std::memcpy(m_matrix, result, sizeof(m_matrix));
 
     return *this;
 }
@@ -161,11 +267,11 @@ Transform& Transform::combine(const Transform& transform)
 ////////////////////////////////////////////////////////////
 Transform& Transform::translate(float x, float y)
 {
-    Transform translation(1, 0, x,
-                          0, 1, y,
-                          0, 0, 1);
+    // Same as combining with a translation matrix, without the multiplications by 0 and 1
+    m_matrix[2] += m_matrix[0] * x + m_matrix[1] * y;
+    m_matrix[5] += m_matrix[3] * x + m_matrix[4] * y;
 
-    return combine(translation);
+    return *this;
 }
 
 
@@ -216,11 +322,13 @@ Transform& Transform::rotate(float angle, const Vector2f& center)
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY)
 {
-    Transform scaling(scaleX, 0,      0,
-                      0,      scaleY, 0,
-                      0,      0,      1);
+    // Same as combining with a scaling matrix, without the multiplications by 0
+    m_matrix[0] *= scaleX;
+    m_matrix[3] *= scaleX;
+    m_matrix[1] *= scaleY;
+    m_matrix[4] *= scaleY;
 
-    return combine(scaling);
+    return *this;
 }
 
 
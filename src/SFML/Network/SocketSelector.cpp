@@ -29,7 +29,14 @@
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <utility>
+#include <vector>
+
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/epoll.h>
+    #include <cerrno>
+#endif
 
 #ifdef _MSC_VER
     #pragma warning(disable : 4127) // "conditional expression is constant" generated by the FD_SET macro
@@ -38,20 +45,290 @@
 
 namespace sf
 {
+#if defined(SFML_SYSTEM_LINUX)
+
+////////////////////////////////////////////////////////////
+/// epoll implementation: the cost of waiting depends only on
+/// the number of ready sockets, and there's no limit on the
+/// number or the value of the handles
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set AllSockets;   ///< Set containing all the sockets handles
-    fd_set SocketsReady; ///< Set containing handles of the sockets that are ready
-    int    MaxSocket;    ///< Maximum socket handle
+    SocketSelectorImpl() :
+    Epoll     (epoll_create(1)),
+    Mode      (LevelTriggered),
+    Count     (0),
+    Generation(1)
+    {
+        if (Epoll < 0)
+            err() << "Failed to create the epoll instance of a socket selector" << std::endl;
+    }
+
+    SocketSelectorImpl(const SocketSelectorImpl& copy) :
+    Epoll     (epoll_create(1)),
+    Mode      (copy.Mode),
+    Count     (0),
+    Generation(1)
+    {
+        // The epoll instance can't be shared, register the same sockets in a new one
+        for (std::size_t i = 0; i < copy.Sockets.size(); ++i)
+        {
+            if (copy.Sockets[i])
+                add(*copy.Sockets[i]);
+        }
+    }
+
+    ~SocketSelectorImpl()
+    {
+        if (Epoll >= 0)
+            ::close(Epoll);
+    }
+
+    void add(Socket& socket)
+    {
+        SocketHandle handle = socket.getHandle();
+        if (handle == priv::SocketImpl::invalidSocket())
+            return;
+
+        epoll_event event = epoll_event();
+        event.events = getEvents();
+        event.data.fd = handle;
+
+        if (static_cast<std::size_t>(handle) >= Sockets.size())
+        {
+            Sockets.resize(handle + 1, NULL);
+            ReadyStamps.resize(handle + 1, 0);
+        }
+
+        // Update the registration if the handle was already added
+        if (epoll_ctl(Epoll, EPOLL_CTL_ADD, handle, &event) != 0)
+        {
+            if ((errno != EEXIST) || (epoll_ctl(Epoll, EPOLL_CTL_MOD, handle, &event) != 0))
+                return;
+        }
+
+        // The entry may belong to a socket that was closed without being removed
+        if (!Sockets[handle])
+            Count++;
+        Sockets[handle] = &socket;
+    }
+
+    void remove(Socket& socket)
+    {
+        SocketHandle handle = socket.getHandle();
+        if ((handle == priv::SocketImpl::invalidSocket()) || (static_cast<std::size_t>(handle) >= Sockets.size()) || (Sockets[handle] != &socket))
+        {
+            // The socket was closed after being added: its handle has been
+            // removed from the epoll instance by the system, just forget it
+            std::vector<Socket*>::iterator it = std::find(Sockets.begin(), Sockets.end(), &socket);
+            if (it == Sockets.end())
+                return;
+            handle = static_cast<SocketHandle>(it - Sockets.begin());
+        }
+        else
+        {
+            epoll_event event = epoll_event();
+            epoll_ctl(Epoll, EPOLL_CTL_DEL, handle, &event);
+        }
+
+        Sockets[handle] = NULL;
+        ReadyStamps[handle] = 0;
+        Count--;
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < Sockets.size(); ++i)
+        {
+            if (Sockets[i])
+            {
+                epoll_event event = epoll_event();
+                epoll_ctl(Epoll, EPOLL_CTL_DEL, static_cast<int>(i), &event);
+            }
+        }
+
+        Sockets.clear();
+        ReadyStamps.clear();
+        Count = 0;
+    }
+
+    bool wait(Time timeout)
+    {
+        // Zero means infinite; round up so that a small timeout doesn't become a poll
+        int milliseconds = -1;
+        if (timeout != Time::Zero)
+            milliseconds = static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+
+        Events.resize(std::max<std::size_t>(Count, 1));
+        int count = epoll_wait(Epoll, &Events[0], static_cast<int>(Events.size()), milliseconds);
+
+        // A new generation invalidates the ready stamps of the previous wait
+        if (++Generation == 0)
+        {
+            std::fill(ReadyStamps.begin(), ReadyStamps.end(), 0);
+            Generation = 1;
+        }
+
+        // The system keeps reporting a handle which was closed without being removed if
+        // it is still open elsewhere (duplicated or inherited), so events are matched
+        // against the sockets currently registered rather than trusted blindly
+        bool ready = false;
+        for (int i = 0; i < count; ++i)
+        {
+            int handle = Events[i].data.fd;
+            if ((handle < 0) || (static_cast<std::size_t>(handle) >= Sockets.size()))
+                continue;
+
+            Socket* socket = Sockets[handle];
+            if (!socket || (socket->getHandle() != handle))
+                continue;
+
+            ReadyStamps[handle] = Generation;
+            Ready.push_back(socket);
+            ready = true;
+        }
+
+        return ready;
+    }
+
+    bool isReady(Socket& socket) const
+    {
+        SocketHandle handle = socket.getHandle();
+        return (handle != priv::SocketImpl::invalidSocket()) &&
+               (static_cast<std::size_t>(handle) < ReadyStamps.size()) &&
+               (ReadyStamps[handle] == Generation);
+    }
+
+    void setMode(TriggerMode mode)
+    {
+        Mode = mode;
+
+        epoll_event event = epoll_event();
+        event.events = getEvents();
+        for (std::size_t i = 0; i < Sockets.size(); ++i)
+        {
+            if (Sockets[i])
+            {
+                event.data.fd = static_cast<int>(i);
+                epoll_ctl(Epoll, EPOLL_CTL_MOD, static_cast<int>(i), &event);
+            }
+        }
+    }
+
+    Uint32 getEvents() const
+    {
+        return Mode == EdgeTriggered ? EPOLLIN | EPOLLET : EPOLLIN;
+    }
+
+    int                       Epoll;       ///< Handle of the epoll instance
+    TriggerMode               Mode;        ///< How ready sockets are reported
+    std::vector<Socket*>      Sockets;     ///< Sockets added to the selector, indexed by handle
+    std::vector<unsigned int> ReadyStamps; ///< Generation of the last wait that reported each handle, indexed by handle
+    std::vector<epoll_event>  Events;      ///< Buffer receiving the events of epoll_wait
+    std::vector<Socket*>      Ready;       ///< Sockets found ready by the last wait
+    std::size_t               Count;       ///< Number of sockets added to the selector
+    unsigned int              Generation;  ///< Number of the last wait
 };
 
+#else
+
+////////////////////////////////////////////////////////////
+/// select implementation
+////////////////////////////////////////////////////////////
+struct SocketSelector::SocketSelectorImpl
+{
+    SocketSelectorImpl() :
+    Mode(LevelTriggered)
+    {
+        clear();
+    }
+
+    void add(Socket& socket)
+    {
+        SocketHandle handle = socket.getHandle();
+        if (handle != priv::SocketImpl::invalidSocket())
+        {
+            FD_SET(handle, &AllSockets);
+
+            int size = static_cast<int>(handle);
+            if (size > MaxSocket)
+                MaxSocket = size;
+
+            if (std::find(Sockets.begin(), Sockets.end(), &socket) == Sockets.end())
+                Sockets.push_back(&socket);
+        }
+    }
+
+    void remove(Socket& socket)
+    {
+        FD_CLR(socket.getHandle(), &AllSockets);
+        FD_CLR(socket.getHandle(), &SocketsReady);
+
+        Sockets.erase(std::remove(Sockets.begin(), Sockets.end(), &socket), Sockets.end());
+    }
+
+    void clear()
+    {
+        FD_ZERO(&AllSockets);
+        FD_ZERO(&SocketsReady);
+
+        MaxSocket = 0;
+        Sockets.clear();
+    }
+
+    bool wait(Time timeout)
+    {
+        // Setup the timeout
+        timeval time;
+        time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
+        time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
+
+        // Initialize the set that will contain the sockets that are ready
+        SocketsReady = AllSockets;
+
+        // Wait until one of the sockets is ready for reading, or timeout is reached
+        int count = select(MaxSocket + 1, &SocketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+
+        // Build the list of ready sockets
+        if (count > 0)
+        {
+            for (std::vector<Socket*>::const_iterator it = Sockets.begin(); it != Sockets.end(); ++it)
+            {
+                if (isReady(**it))
+                    Ready.push_back(*it);
+            }
+        }
+
+        return count > 0;
+    }
+
+    bool isReady(Socket& socket) const
+    {
+        return FD_ISSET(socket.getHandle(), &SocketsReady) != 0;
+    }
+
+    void setMode(TriggerMode mode)
+    {
+        // Only level-triggered notifications are possible with select
+        Mode = mode;
+    }
+
+    fd_set               AllSockets;   ///< Set containing all the sockets handles
+    fd_set               SocketsReady; ///< Set containing handles of the sockets that are ready
+    int                  MaxSocket;    ///< Maximum socket handle
+    TriggerMode          Mode;         ///< Trigger mode requested by the user
+    std::vector<Socket*> Sockets;      ///< Sockets added to the selector
+    std::vector<Socket*> Ready;        ///< Sockets found ready by the last wait
+};
+
+#endif
+
 
 ////////////////////////////////////////////////////////////
 SocketSelector::SocketSelector() :
 m_impl(new SocketSelectorImpl)
 {
-    clear();
+
 }
 
 
@@ -73,58 +350,69 @@ SocketSelector::~SocketSelector()
 ////////////////////////////////////////////////////////////
 void SocketSelector::add(Socket& socket)
 {
-    SocketHandle handle = socket.getHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
-    {
-        FD_SET(handle, &m_impl->AllSockets);
-
-        int size = static_cast<int>(handle);
-        if (size > m_impl->MaxSocket)
-            m_impl->MaxSocket = size;
-    }
+    m_impl->add(socket);
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::remove(Socket& socket)
 {
-    FD_CLR(socket.getHandle(), &m_impl->AllSockets);
-    FD_CLR(socket.getHandle(), &m_impl->SocketsReady);
+    m_impl->remove(socket);
+
+    // Keep the indices of the ready list stable, so that it can be iterated while removing sockets
+    std::replace(m_impl->Ready.begin(), m_impl->Ready.end(), &socket, static_cast<Socket*>(NULL));
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::clear()
 {
-    FD_ZERO(&m_impl->AllSockets);
-    FD_ZERO(&m_impl->SocketsReady);
-
-    m_impl->MaxSocket = 0;
+    m_impl->clear();
+    m_impl->Ready.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
-    // Setup the timeout
-    timeval time;
-    time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
-    time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
+    m_impl->Ready.clear();
 
-    // Initialize the set that will contain the sockets that are ready
-    m_impl->SocketsReady = m_impl->AllSockets;
+    return m_impl->wait(timeout);
+}
 
-    // Wait until one of the sockets is ready for reading, or timeout is reached
-    int count = select(m_impl->MaxSocket + 1, &m_impl->SocketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
 
-    return count > 0;
+////////////////////////////////////////////////////////////
+bool SocketSelector::isReady(Socket& socket) const
+{
+    return m_impl->isReady(socket);
 }
 
 
 ////////////////////////////////////////////////////////////
-bool SocketSelector::isReady(Socket& socket) const
+std::size_t SocketSelector::getReadyCount() const
+{
+    return m_impl->Ready.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket* SocketSelector::getReadySocket(std::size_t index) const
+{
+    return index < m_impl->Ready.size() ? m_impl->Ready[index] : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::setTriggerMode(TriggerMode mode)
+{
+    m_impl->setMode(mode);
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::TriggerMode SocketSelector::getTriggerMode() const
 {
-    return FD_ISSET(socket.getHandle(), &m_impl->SocketsReady) != 0;
+    return m_impl->Mode;
 }
 
 
@@ -30,6 +30,7 @@
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <algorithm>
 #include <cstring>
 
@@ -46,6 +47,71 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Minimum size of the buffer used to receive packets
+    const std::size_t minimumBufferSize = 4096;
+
+    // Size above which the receive buffer is released once it is empty
+    const std::size_t maximumIdleBufferSize = 65536;
+
+    // Largest packet accepted by receive(Packet&); the size comes from the remote peer, so it can't be trusted
+    const sf::Uint32 maximumPacketSize = 256 * 1024 * 1024;
+
+    // Number of packets gathered into a single system call by send(Packet*, std::size_t)
+    const std::size_t packetsPerBatch = 256;
+
+    // Send a list of blocks in order, with as few system calls as possible.
+    // The arrays are modified to keep track of what remains to be sent.
+    sf::Socket::Status sendBlocks(sf::SocketHandle handle, const void** data, std::size_t* sizes, std::size_t count)
+    {
+        std::size_t first = 0;
+        while (first < count)
+        {
+            // Send as much as possible
+            int sent = sf::priv::SocketImpl::sendBuffers(handle, data + first, sizes + first, count - first, flags);
+
+            // Check for errors
+            if (sent < 0)
+                return sf::priv::SocketImpl::getErrorStatus();
+
+            // Skip the blocks that were completely sent, and advance into the partially sent one
+            std::size_t remaining = static_cast<std::size_t>(sent);
+            while ((first < count) && (remaining >= sizes[first]))
+                remaining -= sizes[first++];
+
+            if (remaining > 0)
+            {
+                data[first] = static_cast<const char*>(data[first]) + remaining;
+                sizes[first] -= remaining;
+            }
+        }
+
+        return sf::Socket::Done;
+    }
+
+    // Receive bytes directly from the system
+    sf::Socket::Status receiveBytes(sf::SocketHandle handle, char* data, std::size_t size, std::size_t& received)
+    {
+        received = 0;
+
+        // Receive a chunk of bytes
+        int sizeReceived = recv(handle, data, static_cast<int>(size), flags);
+
+        // Check the number of bytes received
+        if (sizeReceived > 0)
+        {
+            received = static_cast<std::size_t>(sizeReceived);
+            return sf::Socket::Done;
+        }
+        else if (sizeReceived == 0)
+        {
+            return sf::Socket::Disconnected;
+        }
+        else
+        {
+            return sf::priv::SocketImpl::getErrorStatus();
+        }
+    }
 }
 
 namespace sf
@@ -211,14 +277,16 @@ void TcpSocket::disconnect()
     // Close the socket
     close();
 
-    // Reset the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Drop the received data
+    m_receiveBuffer = ReceiveBuffer();
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(const void* data, std::size_t size)
 {
+    SFML_PROFILE_ZONE("TcpSocket::send");
+
     // Check the parameters
     if (!data || (size == 0))
     {
@@ -246,6 +314,8 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size)
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& received)
 {
+    SFML_PROFILE_ZONE("TcpSocket::receive");
+
     // First clear the variables to fill
     received = 0;
 
@@ -256,23 +326,20 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
-    // Receive a chunk of bytes
-    int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
-
-    // Check the number of bytes received
-    if (sizeReceived > 0)
+    // Bytes read ahead by receive(Packet&) come first
+    ReceiveBuffer& buffer = m_receiveBuffer;
+    if (buffer.End > buffer.Begin)
     {
-        received = static_cast<std::size_t>(sizeReceived);
+        received = std::min(size, buffer.End - buffer.Begin);
+        std::memcpy(data, &buffer.Data[buffer.Begin], received);
+        buffer.Begin += received;
+        if (buffer.Begin == buffer.End)
+            buffer.Begin = buffer.End = 0;
+
         return Done;
     }
-    else if (sizeReceived == 0)
-    {
-        return Socket::Disconnected;
-    }
-    else
-    {
-        return priv::SocketImpl::getErrorStatus();
-    }
+
+    return receiveBytes(getHandle(), static_cast<char*>(data), size, received);
 }
 
 
@@ -283,98 +350,147 @@ Socket::Status TcpSocket::send(Packet& packet)
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
-
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
-
-    // First convert the packet size to network byte order
-    Uint32 packetSize = htonl(static_cast<Uint32>(size));
- 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
- 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
-
-    // Send the data block
-    return send(&blockToSend[0], blockToSend.size());
+    // The size and the data are gathered by the system into a single
+    // send, straight from the packet: there's no intermediate copy,
+    // and a partial send just continues where it stopped.
+    return send(&packet, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-Socket::Status TcpSocket::receive(Packet& packet)
+Socket::Status TcpSocket::send(Packet* packets, std::size_t count)
 {
-    // First clear the variables to fill
-    packet.clear();
+    SFML_PROFILE_ZONE("TcpSocket::send");
+
+    if (!packets && (count > 0))
+    {
+        err() << "Cannot send packets over the network (the packet array is invalid)" << std::endl;
+        return Error;
+    }
 
-    // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
-    std::size_t received = 0;
-    if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+    // Each packet is made of two blocks: its size, in network byte order, and its data
+    Uint32      packetSizes[packetsPerBatch];
+    const void* data[packetsPerBatch * 2];
+    std::size_t sizes[packetsPerBatch * 2];
+
+    for (std::size_t start = 0; start < count; start += packetsPerBatch)
     {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+        std::size_t blocks = 0;
+        std::size_t end = std::min(start + packetsPerBatch, count);
+        for (std::size_t i = start; i < end; ++i)
         {
-            char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
-            m_pendingPacket.SizeReceived += received;
+            std::size_t size = 0;
+            const void* packetData = packets[i].onSend(size);
+            packetSizes[i - start] = htonl(static_cast<Uint32>(size));
+
+            data[blocks] = &packetSizes[i - start];
+            sizes[blocks++] = sizeof(Uint32);
 
-            if (status != Done)
-                return status;
+            if (size > 0)
+            {
+                data[blocks] = packetData;
+                sizes[blocks++] = size;
+            }
         }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
-    }
-    else
-    {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
+        Status status = sendBlocks(getHandle(), data, sizes, blocks);
+        if (status != Done)
+            return status;
     }
 
-    // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receive(Packet& packet)
+{
+    SFML_PROFILE_ZONE("TcpSocket::receive");
+
+    // First clear the variables to fill
+    packet.clear();
+
+    // Packets are framed directly in the receive buffer: several packets
+    // may come from a single call to recv, and their data is handed to the
+    // user packet without any intermediate copy
+    ReceiveBuffer& buffer = m_receiveBuffer;
+    while (true)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
-        if (status != Done)
-            return status;
+        // Check whether the buffer already contains a whole packet
+        std::size_t available = buffer.End - buffer.Begin;
+        std::size_t needed = sizeof(Uint32);
+        if (available >= sizeof(Uint32))
+        {
+            Uint32 packetSize = 0;
+            std::memcpy(&packetSize, &buffer.Data[buffer.Begin], sizeof(packetSize));
+            packetSize = ntohl(packetSize);
+
+            // Reject sizes that we can't (or don't want to) store
+            if ((packetSize > maximumPacketSize) || (packetSize > static_cast<std::size_t>(-1) - sizeof(Uint32)))
+            {
+                err() << "Cannot receive packet from the network (packet size " << packetSize << " exceeds the limit of " << maximumPacketSize << " bytes)" << std::endl;
+                return Error;
+            }
+            needed += packetSize;
+
+            if (available >= needed)
+            {
+                if (needed > sizeof(Uint32))
+                    packet.onReceive(&buffer.Data[buffer.Begin + sizeof(Uint32)], needed - sizeof(Uint32));
 
-        // Append it into the packet
-        if (received > 0)
+                buffer.Begin += needed;
+                if (buffer.Begin == buffer.End)
+                {
+                    // Don't keep a huge buffer around after receiving a big packet
+                    if (buffer.Data.size() > maximumIdleBufferSize)
+                        buffer = ReceiveBuffer();
+
+                    buffer.Begin = buffer.End = 0;
+                }
+
+                return Done;
+            }
+        }
+
+        // Make room for the rest of the packet at the end of the buffer
+        if (buffer.Begin + needed > buffer.Data.size())
         {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
+            if (buffer.Begin > 0)
+            {
+                std::memmove(&buffer.Data[0], &buffer.Data[buffer.Begin], available);
+                buffer.Begin = 0;
+                buffer.End = available;
+            }
+
+            // Grow the buffer as the data arrives, rather than allocating the size announced by the peer
+            if ((needed > buffer.Data.size()) && (buffer.End == buffer.Data.size()))
+                buffer.Data.resize(std::max(minimumBufferSize, std::min(needed, buffer.Data.size() * 2)));
         }
-    }
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
+        // In non-blocking mode, get everything the system has so that the next
+        // packets don't need another call; in blocking mode, only read what the
+        // current packet needs, so that we don't hide pending data from selectors
+        std::size_t space = buffer.Data.size() - buffer.End;
+        std::size_t sizeToGet = isBlocking() ? std::min(buffer.Begin + needed - buffer.End, space) : space;
+        std::size_t received = 0;
+        Status status = receiveBytes(getHandle(), &buffer.Data[buffer.End], sizeToGet, received);
+        buffer.End += received;
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+        if (status != Done)
+            return status;
 
-    return Done;
+        // A short read in non-blocking mode means that the system has nothing more for now
+        if (!isBlocking() && (received < sizeToGet) && (buffer.End - buffer.Begin < needed))
+            return NotReady;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-TcpSocket::PendingPacket::PendingPacket() :
-Size        (0),
-SizeReceived(0),
-Data        ()
+TcpSocket::ReceiveBuffer::ReceiveBuffer() :
+Data (),
+Begin(0),
+End  (0)
 {
 
 }
@@ -31,6 +31,36 @@
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Maximum number of datagrams sent with a single system call
+    const std::size_t sendBatchSize = 64;
+
+    // Maximum number of datagrams received with a single system call;
+    // each one needs a buffer of MaxDatagramSize bytes
+    const std::size_t receiveBatchSize = 16;
+
+    #if !defined(SFML_SYSTEM_LINUX)
+
+        // Check if a datagram can be read without blocking
+        bool isReadable(sf::SocketHandle handle)
+        {
+            fd_set set;
+            FD_ZERO(&set);
+            FD_SET(handle, &set);
+
+            timeval time;
+            time.tv_sec  = 0;
+            time.tv_usec = 0;
+
+            return select(static_cast<int>(handle + 1), &set, NULL, NULL, &time) > 0;
+        }
+
+    #endif
+}
 
 
 namespace sf
@@ -190,4 +220,182 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::send(Datagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    // First clear the variables to fill
+    sent = 0;
+
+    // Check the parameters
+    if (!datagrams && (count > 0))
+    {
+        err() << "Cannot send data over the network (the datagram array is invalid)" << std::endl;
+        return Error;
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Create the internal socket if it doesn't exist
+    create();
+
+    mmsghdr     messages[sendBatchSize];
+    iovec       buffers[sendBatchSize];
+    sockaddr_in addresses[sendBatchSize];
+
+    while (sent < count)
+    {
+        // Gather the next datagrams
+        std::size_t batch = std::min(count - sent, sendBatchSize);
+        std::memset(messages, 0, batch * sizeof(*messages));
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            Datagram& datagram = datagrams[sent + i];
+
+            std::size_t size = 0;
+            const void* data = datagram.packet.onSend(size);
+            if (size > MaxDatagramSize)
+            {
+                err() << "Cannot send data over the network "
+                      << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+                return Error;
+            }
+
+            addresses[i] = priv::SocketImpl::createAddress(datagram.remoteAddress.toInteger(), datagram.remotePort);
+            buffers[i].iov_base = const_cast<void*>(data);
+            buffers[i].iov_len  = size;
+
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Send them all with a single system call
+        int result = sendmmsg(getHandle(), messages, static_cast<unsigned int>(batch), 0);
+
+        // Check for errors
+        if (result < 0)
+            return priv::SocketImpl::getErrorStatus();
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+#else
+
+    // No batched system call, send the datagrams one by one
+    for (; sent < count; ++sent)
+    {
+        Datagram& datagram = datagrams[sent];
+        Status status = send(datagram.packet, datagram.remoteAddress, datagram.remotePort);
+        if (status != Done)
+            return status;
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    // First clear the variables to fill
+    received = 0;
+
+    // Check the destination array
+    if (!datagrams || (count == 0))
+    {
+        err() << "Cannot receive data from the network (the datagram array is invalid)" << std::endl;
+        return Error;
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Make room for a batch of datagrams, no bigger than requested; the buffer is local
+    // so that the socket doesn't keep it after a single batched call
+    std::vector<char> buffer(std::min(count, receiveBatchSize) * MaxDatagramSize);
+
+    mmsghdr     messages[receiveBatchSize];
+    iovec       buffers[receiveBatchSize];
+    sockaddr_in addresses[receiveBatchSize];
+
+    // Only the first datagram may be waited for
+    int flags = MSG_WAITFORONE;
+
+    while (received < count)
+    {
+        std::size_t batch = std::min(count - received, receiveBatchSize);
+        std::memset(messages, 0, batch * sizeof(*messages));
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            buffers[i].iov_base = &buffer[i * MaxDatagramSize];
+            buffers[i].iov_len  = MaxDatagramSize;
+
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Receive as many datagrams as possible with a single system call
+        int result = recvmmsg(getHandle(), messages, static_cast<unsigned int>(batch), flags, NULL);
+
+        // Check for errors; the datagrams already received are still valid
+        if (result < 0)
+        {
+            if (received > 0)
+                break;
+
+            return priv::SocketImpl::getErrorStatus();
+        }
+
+        // Copy the datagrams to the user slots
+        for (int i = 0; i < result; ++i)
+        {
+            Datagram& datagram = datagrams[received++];
+
+            datagram.packet.clear();
+            if (messages[i].msg_len > 0)
+                datagram.packet.onReceive(&buffer[i * MaxDatagramSize], messages[i].msg_len);
+
+            datagram.remoteAddress = IpAddress(ntohl(addresses[i].sin_addr.s_addr));
+            datagram.remotePort    = ntohs(addresses[i].sin_port);
+        }
+
+        // Stop as soon as the queue is empty
+        if (static_cast<std::size_t>(result) < batch)
+            break;
+
+        flags = MSG_DONTWAIT;
+    }
+
+#else
+
+    // No batched system call, receive the datagrams one by one
+    while (received < count)
+    {
+        // Only the first datagram may be waited for
+        if ((received > 0) && !isReadable(getHandle()))
+            break;
+
+        Datagram& datagram = datagrams[received];
+        Status status = receive(datagram.packet, datagram.remoteAddress, datagram.remotePort);
+        if (status != Done)
+        {
+            if (received > 0)
+                break;
+
+            return status;
+        }
+
+        received++;
+    }
+
+#endif
+
+    return Done;
+}
+
+
 } // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Unix/SocketImpl.hpp>
+#include <sys/uio.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <cstring>
@@ -77,6 +78,29 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, const void* const* data, const std::size_t* sizes, std::size_t count, int flags)
+{
+    // Don't exceed the system limit, the caller will send the rest with the next call
+    iovec buffers[512];
+    if (count > sizeof(buffers) / sizeof(*buffers))
+        count = sizeof(buffers) / sizeof(*buffers);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        buffers[i].iov_base = const_cast<void*>(data[i]);
+        buffers[i].iov_len  = sizes[i];
+    }
+
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = count;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
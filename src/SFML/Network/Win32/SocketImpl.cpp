@@ -68,6 +68,28 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, const void* const* data, const std::size_t* sizes, std::size_t count, int flags)
+{
+    // Send at most 512 blocks at once, the caller will send the rest with the next call
+    WSABUF buffers[512];
+    if (count > sizeof(buffers) / sizeof(*buffers))
+        count = sizeof(buffers) / sizeof(*buffers);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        buffers[i].buf = const_cast<CHAR*>(static_cast<const CHAR*>(data[i]));
+        buffers[i].len = static_cast<ULONG>(sizes[i]);
+    }
+
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
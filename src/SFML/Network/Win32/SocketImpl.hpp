@@ -95,6 +95,23 @@ public :
     ////////////////////////////////////////////////////////////
     static void setBlocking(SocketHandle sock, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several blocks of data with a single system call
+    ///
+    /// Not all the blocks may be sent in one call, the caller
+    /// has to send the remaining bytes again.
+    ///
+    /// \param sock  Handle of the socket
+    /// \param data  Array of pointers to the blocks to send
+    /// \param sizes Array of sizes of the blocks to send, in bytes
+    /// \param count Number of blocks
+    /// \param flags Flags to pass to the system call
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendBuffers(SocketHandle sock, const void* const* data, const std::size_t* sizes, std::size_t count, int flags);
+
     ////////////////////////////////////////////////////////////
     /// Get the last socket error status
     ///
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ConditionVariableImpl.hpp>
+#else
+    #include <SFML/System/Unix/ConditionVariableImpl.hpp>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ConditionVariable::ConditionVariable()
+{
+    m_conditionImpl = new priv::ConditionVariableImpl;
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionVariable::~ConditionVariable()
+{
+    delete m_conditionImpl;
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariable::wait(Mutex& mutex)
+{
+    m_conditionImpl->wait(*mutex.m_mutexImpl);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariable::wait(Mutex& mutex, Time timeout)
+{
+    return m_conditionImpl->wait(*mutex.m_mutexImpl, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariable::notifyOne()
+{
+    m_conditionImpl->notifyOne();
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariable::notifyAll()
+{
+    m_conditionImpl->notifyAll();
+}
+
+} // namespace sf
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FramePacer.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Number of frames which the statistics are computed from
+    const std::size_t historySize = 256;
+
+    // Below this remaining time, the pacer stops yielding and busy-waits
+    const sf::Time yieldThreshold = sf::microseconds(200);
+
+    // Upper bound of the oversleep estimate, so that a single hiccup
+    // (like the thread being preempted) doesn't turn the following
+    // frames into long busy-waits
+    const sf::Time maxSleepError = sf::milliseconds(3);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FramePacer::FramePacer() :
+m_frameTime      (Time::Zero),
+m_spinMargin     (microseconds(500)),
+m_sleepError     (Time::Zero),
+m_deadline       (Time::Zero),
+m_frameStart     (Time::Zero),
+m_historyIndex   (0),
+m_missedDeadlines(0)
+{
+    m_history.reserve(historySize);
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFrameTime(Time frameTime)
+{
+    m_frameTime = std::max(frameTime, Time::Zero);
+    m_deadline = m_frameStart + m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getFrameTime() const
+{
+    return m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setSpinMargin(Time margin)
+{
+    m_spinMargin = std::max(margin, Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::wait()
+{
+    if (m_frameTime != Time::Zero)
+    {
+        if (m_clock.getElapsedTime() > m_deadline)
+            m_missedDeadlines++;
+        else
+            waitUntil(m_deadline);
+
+        // Schedule the next deadline from the previous one, so that a
+        // late frame is compensated by a shorter one; but don't try
+        // to catch up if we are more than a whole frame behind
+        m_deadline += m_frameTime;
+        Time now = m_clock.getElapsedTime();
+        if (now >= m_deadline)
+            m_deadline = now + m_frameTime;
+    }
+
+    Time frameEnd = m_clock.getElapsedTime();
+    Time duration = frameEnd - m_frameStart;
+    m_frameStart = frameEnd;
+
+    // Record the duration of the frame in the circular history
+    if (m_history.size() < historySize)
+        m_history.push_back(duration.asMicroseconds());
+    else
+        m_history[m_historyIndex] = duration.asMicroseconds();
+    m_historyIndex = (m_historyIndex + 1) % historySize;
+
+    return duration;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::reset()
+{
+    m_clock.restart();
+    m_frameStart = Time::Zero;
+    m_deadline = m_frameTime;
+    m_history.clear();
+    m_historyIndex = 0;
+    m_missedDeadlines = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer::Statistics FramePacer::getStatistics() const
+{
+    Statistics statistics;
+    statistics.average         = Time::Zero;
+    statistics.percentile99    = Time::Zero;
+    statistics.maximum         = Time::Zero;
+    statistics.frameCount      = static_cast<unsigned int>(m_history.size());
+    statistics.missedDeadlines = m_missedDeadlines;
+
+    if (m_history.empty())
+        return statistics;
+
+    Int64 total = 0;
+    for (std::size_t i = 0; i < m_history.size(); ++i)
+        total += m_history[i];
+
+    // The percentile is the smallest duration which is not exceeded by 99% of the frames
+    std::vector<Int64> sorted(m_history);
+    std::size_t rank = (sorted.size() * 99 + 99) / 100 - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+    statistics.average      = microseconds(total / static_cast<Int64>(m_history.size()));
+    statistics.percentile99 = microseconds(sorted[rank]);
+    statistics.maximum      = microseconds(*std::max_element(m_history.begin(), m_history.end()));
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::waitUntil(Time deadline)
+{
+    // Sleep for the bulk of the remaining time, leaving enough margin to absorb the OS oversleeping
+    Time start = m_clock.getElapsedTime();
+    Time margin = std::max(m_spinMargin, m_sleepError);
+    if (deadline - start > margin)
+    {
+        Time requested = deadline - start - margin;
+        sleep(requested);
+
+        // Update the oversleep estimate: it grows immediately, and decays slowly
+        Time error = m_clock.getElapsedTime() - start - requested;
+        error = std::min(std::max(error, Time::Zero), maxSleepError);
+        if (error > m_sleepError)
+            m_sleepError = error;
+        else
+            m_sleepError = microseconds((m_sleepError.asMicroseconds() * 15 + error.asMicroseconds()) / 16);
+    }
+
+    // Yield the remaining time away, then busy-wait for the last part
+    Time remaining = deadline - m_clock.getElapsedTime();
+    while (remaining > Time::Zero)
+    {
+        if (remaining > yieldThreshold)
+            sleep(Time::Zero);
+
+        remaining = deadline - m_clock.getElapsedTime();
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/SpscQueue.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <vector>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ClockImpl.hpp>
+#else
+    #include <SFML/System/Unix/ClockImpl.hpp>
+#endif
+
+// On x86, zones are timed with the time stamp counter, which is an
+// order of magnitude cheaper to read than the system clock
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    #define SFML_PROFILER_USE_TSC
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #include <x86intrin.h>
+    #define SFML_PROFILER_USE_TSC
+#endif
+
+
+namespace
+{
+    // Number of zones that each thread can record before they are saved
+    const std::size_t bufferCapacity = 65536;
+
+    // Read the time source of the zones, in ticks
+    inline sf::Uint64 getTicks()
+    {
+#ifdef SFML_PROFILER_USE_TSC
+        return __rdtsc();
+#else
+        return sf::priv::ClockImpl::getCurrentNanoseconds();
+#endif
+    }
+
+    // A recorded zone, in ticks
+    struct Event
+    {
+        const char* name;
+        sf::Uint64  start;
+        sf::Uint64  duration;
+    };
+
+    // The zones recorded by a thread; only this thread pushes, and
+    // only saveToFile pops (with the registry mutex locked)
+    struct ThreadBuffer
+    {
+        ThreadBuffer() :
+        events (bufferCapacity),
+        id     (0),
+        name   (NULL),
+        dropped(0)
+        {
+        }
+
+        sf::SpscQueue<Event> events;
+        unsigned int         id;
+        const std::string*   name;
+        volatile std::size_t dropped;
+    };
+
+    // The zones of a finished thread which are not saved yet
+    struct FinishedThread
+    {
+        unsigned int       id;
+        const std::string* name;
+        std::vector<Event> events;
+    };
+
+    // Buffer and name of each thread; names are shared between the threads
+    // so that naming a thread never allocates more than once per name
+    sf::ThreadLocalPtr<ThreadBuffer> currentBuffer(NULL);
+    sf::ThreadLocalPtr<std::string> currentName(NULL);
+    std::list<std::string> names;
+
+    // Buffers of the live threads; when a thread finishes, its zones are
+    // moved out of its buffer, which is then kept for reuse by the next threads
+    std::vector<ThreadBuffer*> buffers;
+    std::vector<ThreadBuffer*> freeBuffers;
+    std::vector<FinishedThread> finishedThreads;
+    unsigned int nextThreadId = 0;
+    sf::Uint64 finishedDropped = 0;
+    sf::Mutex buffersMutex;
+
+    // Is the profiler recording?
+    volatile std::size_t enabled = 0;
+
+    // Time which the timestamps of the trace are relative to, in ticks and
+    // in nanoseconds; the tick rate is measured against the latter
+    const sf::Uint64 originTicks = getTicks();
+    const sf::Uint64 originNanoseconds = sf::priv::ClockImpl::getCurrentNanoseconds();
+
+    // Get the buffer of the calling thread, creating it on first use
+    ThreadBuffer* getBuffer()
+    {
+        ThreadBuffer* buffer = currentBuffer;
+        if (!buffer)
+        {
+            sf::Lock lock(buffersMutex);
+            if (!freeBuffers.empty())
+            {
+                buffer = freeBuffers.back();
+                freeBuffers.pop_back();
+                buffer->dropped = 0;
+            }
+            else
+            {
+                buffer = new ThreadBuffer;
+            }
+            buffer->id = nextThreadId++;
+            buffer->name = currentName;
+            buffers.push_back(buffer);
+            currentBuffer = buffer;
+        }
+
+        return buffer;
+    }
+
+    // Write a string as a JSON string literal
+    void writeString(std::ostream& stream, const char* string)
+    {
+        stream << '"';
+        for (; *string; ++string)
+        {
+            char c = *string;
+            if ((c == '"') || (c == '\\'))
+                stream << '\\' << c;
+            else if (static_cast<unsigned char>(c) >= 0x20)
+                stream << c;
+        }
+        stream << '"';
+    }
+
+    // Write a time in nanoseconds as microseconds, the unit of Chrome traces
+    void writeTime(std::ostream& stream, double time)
+    {
+        sf::Uint64 nanoseconds = time > 0 ? static_cast<sf::Uint64>(time + 0.5) : 0;
+        sf::Uint64 fraction = nanoseconds % 1000;
+        stream << nanoseconds / 1000 << '.' << static_cast<char>('0' + fraction / 100)
+                                            << static_cast<char>('0' + fraction / 10 % 10)
+                                            << static_cast<char>('0' + fraction % 10);
+    }
+
+    // Write the metadata event which names a thread
+    void writeThreadName(std::ostream& stream, unsigned int id, const std::string* name, bool& first)
+    {
+        stream << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"pid\":0,\"tid\":" << id << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        if (name)
+        {
+            writeString(stream, name->c_str());
+        }
+        else
+        {
+            stream << "\"Thread " << id << '"';
+        }
+        stream << "}}";
+        first = false;
+    }
+
+    // Write a zone as a complete event
+    void writeEvent(std::ostream& stream, unsigned int id, const Event& event, double tickDuration)
+    {
+        stream << ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":" << id << ",\"name\":";
+        writeString(stream, event.name);
+        stream << ",\"ts\":";
+        writeTime(stream, static_cast<sf::Int64>(event.start - originTicks) * tickDuration);
+        stream << ",\"dur\":";
+        writeTime(stream, event.duration * tickDuration);
+        stream << '}';
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Profiler::Zone::Zone(const char* name) :
+m_name (NULL),
+m_start(0)
+{
+    if (priv::atomicLoad(enabled))
+    {
+        m_name = name;
+        m_start = getTicks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Profiler::Zone::~Zone()
+{
+    if (!m_name)
+        return;
+
+    Event event;
+    event.name     = m_name;
+    event.start    = m_start;
+    event.duration = getTicks() - m_start;
+
+    ThreadBuffer* buffer = getBuffer();
+    if (!buffer->events.push(event))
+        priv::atomicStore(buffer->dropped, buffer->dropped + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool enable)
+{
+    priv::atomicStore(enabled, enable ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::isEnabled()
+{
+    return priv::atomicLoad(enabled) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::setThreadName(const std::string& name)
+{
+    Lock lock(buffersMutex);
+
+    std::list<std::string>::iterator it = std::find(names.begin(), names.end(), name);
+    if (it == names.end())
+        it = names.insert(names.end(), name);
+
+    currentName = &*it;
+
+    ThreadBuffer* buffer = currentBuffer;
+    if (buffer)
+        buffer->name = currentName;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::saveToFile(const std::string& filename)
+{
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to save profiler trace to \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    // Measure the number of nanoseconds per tick since the origin
+    Uint64 elapsedTicks = getTicks() - originTicks;
+    Uint64 elapsedNanoseconds = priv::ClockImpl::getCurrentNanoseconds() - originNanoseconds;
+    double tickDuration = elapsedTicks ? static_cast<double>(elapsedNanoseconds) / elapsedTicks : 1.0;
+
+    file << "{\"traceEvents\":[";
+    bool first = true;
+
+    Lock lock(buffersMutex);
+
+    // Write the zones of the finished threads, and forget them
+    for (std::vector<FinishedThread>::const_iterator it = finishedThreads.begin(); it != finishedThreads.end(); ++it)
+    {
+        writeThreadName(file, it->id, it->name, first);
+        for (std::vector<Event>::const_iterator event = it->events.begin(); event != it->events.end(); ++event)
+            writeEvent(file, it->id, *event, tickDuration);
+    }
+    std::vector<FinishedThread>().swap(finishedThreads);
+
+    // Write the zones of the live threads
+    for (std::vector<ThreadBuffer*>::iterator it = buffers.begin(); it != buffers.end(); ++it)
+    {
+        ThreadBuffer& buffer = **it;
+        writeThreadName(file, buffer.id, buffer.name, first);
+
+        Event events[256];
+        std::size_t count;
+        while ((count = buffer.events.pop(events, 256)) > 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                writeEvent(file, buffer.id, events[i], tickDuration);
+        }
+    }
+
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        err() << "Failed to save profiler trace to \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Profiler::getDroppedCount()
+{
+    Lock lock(buffersMutex);
+
+    Uint64 count = finishedDropped;
+    for (std::vector<ThreadBuffer*>::iterator it = buffers.begin(); it != buffers.end(); ++it)
+        count += priv::atomicLoad((*it)->dropped);
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::releaseThread()
+{
+    ThreadBuffer* buffer = currentBuffer;
+    currentBuffer = NULL;
+    currentName = NULL;
+
+    if (!buffer)
+        return;
+
+    Lock lock(buffersMutex);
+
+    // Move the zones out of the buffer, so that it can be reused right away
+    std::size_t count = buffer->events.getSize();
+    if (count > 0)
+    {
+        finishedThreads.push_back(FinishedThread());
+        FinishedThread& thread = finishedThreads.back();
+        thread.id = buffer->id;
+        thread.name = buffer->name;
+        thread.events.resize(count);
+        buffer->events.pop(&thread.events[0], count);
+    }
+
+    finishedDropped += buffer->dropped;
+    buffers.erase(std::find(buffers.begin(), buffers.end(), buffer));
+    freeBuffers.push_back(buffer);
+}
+
+} // namespace sf
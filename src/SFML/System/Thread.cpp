@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Thread.hpp>
+#include <SFML/System/Profiler.hpp>
 
 
 #if defined(SFML_SYSTEM_WINDOWS)
@@ -81,6 +82,9 @@ void Thread::terminate()
 void Thread::run()
 {
     m_entryPoint->run();
+
+    // Give the profiling buffer of the thread to the next ones
+    Profiler::releaseThread();
 }
 
 } // namespace sf
@@ -0,0 +1,366 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Lock.hpp>
+#include <deque>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ThreadImpl.hpp>
+#else
+    #include <SFML/System/Unix/ThreadImpl.hpp>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct ThreadPoolTask
+{
+    ThreadPoolTask(ThreadPool* owner, ThreadFunc* taskFunction) :
+    pool      (owner),
+    function  (taskFunction),
+    finished  (false),
+    references(1)
+    {
+    }
+
+    ~ThreadPoolTask()
+    {
+        delete function;
+    }
+
+    // Add a reference to the task
+    void acquire()
+    {
+        Lock lock(mutex);
+        references++;
+    }
+
+    // Remove a reference to the task, and destroy it if it was the last one
+    void release()
+    {
+        bool last;
+        {
+            Lock lock(mutex);
+            last = (--references == 0);
+        }
+        if (last)
+            delete this;
+    }
+
+    // Run the function, then release the reference held by the queue
+    void run()
+    {
+        function->run();
+        {
+            Lock lock(mutex);
+            finished = true;
+            condition.notifyAll();
+        }
+        release();
+    }
+
+    ThreadPool*       pool;       ///< Pool running the task
+    ThreadFunc*       function;   ///< Function to run
+    bool              finished;   ///< Has the function finished?
+    unsigned int      references; ///< Number of handles and queues referring to the task
+    Mutex             mutex;      ///< Mutex protecting finished and references
+    ConditionVariable condition;  ///< Condition notified when the task has finished
+};
+
+
+////////////////////////////////////////////////////////////
+struct ThreadPoolWorker
+{
+    ThreadPoolWorker(ThreadPool* owner, std::size_t workerIndex) :
+    pool  (owner),
+    index (workerIndex),
+    thread(&ThreadPoolWorker::run, this)
+    {
+    }
+
+    void run()
+    {
+        pool->work(this);
+    }
+
+    ThreadPool*                 pool;   ///< Pool owning the worker
+    std::size_t                 index;  ///< Index of the worker in the pool
+    Thread                      thread; ///< Thread running the tasks
+    std::deque<ThreadPoolTask*> tasks;  ///< Queue of pending tasks; the worker takes from the back, thieves from the front
+    Mutex                       mutex;  ///< Mutex protecting the queue
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task() :
+m_task(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task(const Task& copy) :
+m_task(copy.m_task)
+{
+    if (m_task)
+        m_task->acquire();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task(priv::ThreadPoolTask* task) :
+m_task(task)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::~Task()
+{
+    if (m_task)
+        m_task->release();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task& ThreadPool::Task::operator =(const Task& right)
+{
+    if (right.m_task)
+        right.m_task->acquire();
+    if (m_task)
+        m_task->release();
+
+    m_task = right.m_task;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::Task::isFinished() const
+{
+    if (!m_task)
+        return true;
+
+    Lock lock(m_task->mutex);
+    return m_task->finished;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::Task::wait()
+{
+    if (!m_task)
+        return;
+
+    // Help the workers while there are pending tasks, which also avoids deadlocks
+    // when a task waits for another one
+    while (!isFinished() && m_task->pool->runPendingTask(m_task->pool->m_currentWorker))
+    {
+    }
+
+    // The task is being run by another thread, sleep until it has finished
+    Lock lock(m_task->mutex);
+    while (!m_task->finished)
+        m_task->condition.wait(m_task->mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(unsigned int workerCount) :
+m_nextWorker     (0),
+m_pushCount      (0),
+m_sleepingWorkers(0),
+m_running        (true)
+{
+    if (workerCount == 0)
+        workerCount = getHardwareConcurrency();
+
+    // Create all the workers before launching them, as they steal from each other
+    for (unsigned int i = 0; i < workerCount; ++i)
+        m_workers.push_back(new priv::ThreadPoolWorker(this, i));
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+        m_workers[i]->thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+    // Help running the remaining tasks
+    while (runPendingTask(NULL))
+    {
+    }
+
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+        m_condition.notifyAll();
+    }
+
+    // Workers steal from each other, so they must all be stopped before any is destroyed
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->thread.wait();
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        delete m_workers[i];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThreadPool::getWorkerCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThreadPool::getHardwareConcurrency()
+{
+    return priv::ThreadImpl::getHardwareConcurrency();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task ThreadPool::push(priv::ThreadFunc* function)
+{
+    priv::ThreadPoolTask* task = new priv::ThreadPoolTask(this, function);
+
+    // The handle gets its own reference, the queue keeps the initial one
+    Task handle(task);
+    task->acquire();
+
+    // Without workers, the task is run right away
+    if (m_workers.empty())
+    {
+        task->run();
+        return handle;
+    }
+
+    // A worker keeps its own tasks, other threads distribute them among the workers
+    priv::ThreadPoolWorker* worker = m_currentWorker;
+    if (!worker)
+    {
+        Lock lock(m_mutex);
+        worker = m_workers[m_nextWorker];
+        m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+    }
+
+    {
+        Lock lock(worker->mutex);
+        worker->tasks.push_back(task);
+    }
+
+    // Wake up a sleeping worker to run it
+    Lock lock(m_mutex);
+    m_pushCount++;
+    if (m_sleepingWorkers > 0)
+        m_condition.notifyOne();
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::runPendingTask(priv::ThreadPoolWorker* worker)
+{
+    priv::ThreadPoolTask* task = NULL;
+
+    // First look at the most recent task of the worker, it is the most likely to be in cache
+    if (worker)
+    {
+        Lock lock(worker->mutex);
+        if (!worker->tasks.empty())
+        {
+            task = worker->tasks.back();
+            worker->tasks.pop_back();
+        }
+    }
+
+    // Then steal the oldest task of another worker, starting with the next one
+    std::size_t start = worker ? worker->index + 1 : 0;
+    for (std::size_t i = 0; !task && (i < m_workers.size()); ++i)
+    {
+        priv::ThreadPoolWorker* victim = m_workers[(start + i) % m_workers.size()];
+        if (victim == worker)
+            continue;
+
+        Lock lock(victim->mutex);
+        if (!victim->tasks.empty())
+        {
+            task = victim->tasks.front();
+            victim->tasks.pop_front();
+        }
+    }
+
+    if (!task)
+        return false;
+
+    task->run();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::work(priv::ThreadPoolWorker* worker)
+{
+    m_currentWorker = worker;
+
+    for (;;)
+    {
+        // Remember how many tasks were pushed, to notice those pushed while looking at the queues
+        unsigned int pushCount;
+        {
+            Lock lock(m_mutex);
+            pushCount = m_pushCount;
+        }
+
+        if (runPendingTask(worker))
+            continue;
+
+        // Sleep until a new task is pushed; the pool is only stopped once all the queues are empty
+        Lock lock(m_mutex);
+        while (m_running && (m_pushCount == pushCount))
+        {
+            m_sleepingWorkers++;
+            m_condition.wait(m_mutex);
+            m_sleepingWorkers--;
+        }
+
+        if (!m_running && (m_pushCount == pushCount))
+            break;
+    }
+}
+
+} // namespace sf
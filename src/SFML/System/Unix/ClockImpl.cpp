@@ -59,6 +59,26 @@ Time ClockImpl::getCurrentTime()
 #endif
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 ClockImpl::getCurrentNanoseconds()
+{
+#ifdef SFML_SYSTEM_MACOS
+
+    static mach_timebase_info_data_t frequency = {0, 0};
+    if (frequency.denom == 0)
+        mach_timebase_info(&frequency);
+    return mach_absolute_time() * frequency.numer / frequency.denom;
+
+#else
+
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<Uint64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/ConditionVariableImpl.hpp>
+#include <SFML/System/Unix/MutexImpl.hpp>
+#include <errno.h>
+#include <time.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::ConditionVariableImpl()
+{
+#if defined(SFML_SYSTEM_MACOS)
+
+    pthread_cond_init(&m_condition, NULL);
+
+#else
+
+    // Measure timeouts with the monotonic clock, so that they are not
+    // affected by changes of the system time
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_condition, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::~ConditionVariableImpl()
+{
+    pthread_cond_destroy(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(MutexImpl& mutex)
+{
+    pthread_cond_wait(&m_condition, &mutex.m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    Int64 usecs = timeout.asMicroseconds();
+    if (usecs < 0)
+        usecs = 0;
+
+#if defined(SFML_SYSTEM_MACOS)
+
+    // Mac OS X doesn't support the monotonic clock, but it can wait for a relative time
+    timespec delay;
+    delay.tv_sec  = static_cast<time_t>(usecs / 1000000);
+    delay.tv_nsec = static_cast<long>(usecs % 1000000) * 1000;
+
+    return pthread_cond_timedwait_relative_np(&m_condition, &mutex.m_mutex, &delay) != ETIMEDOUT;
+
+#else
+
+    // Compute the absolute end of the wait
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    end.tv_sec  += static_cast<time_t>(usecs / 1000000);
+    end.tv_nsec += static_cast<long>(usecs % 1000000) * 1000;
+    if (end.tv_nsec >= 1000000000)
+    {
+        end.tv_sec++;
+        end.tv_nsec -= 1000000000;
+    }
+
+    return pthread_cond_timedwait(&m_condition, &mutex.m_mutex, &end) != ETIMEDOUT;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyOne()
+{
+    pthread_cond_signal(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyAll()
+{
+    pthread_cond_broadcast(&m_condition);
+}
+
+} // namespace priv
+
+} // namespace sf
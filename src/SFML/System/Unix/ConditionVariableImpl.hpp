@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONDITIONVARIABLEIMPL_HPP
+#define SFML_CONDITIONVARIABLEIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <pthread.h>
+
+
+namespace sf
+{
+namespace priv
+{
+class MutexImpl;
+
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of condition variables
+////////////////////////////////////////////////////////////
+class ConditionVariableImpl : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariableImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ConditionVariableImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition is notified
+    ///
+    /// \param mutex Locked mutex to release while waiting
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(MutexImpl& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition is notified, or a timeout expires
+    ///
+    /// \param mutex   Locked mutex to release while waiting
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(MutexImpl& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one waiting thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the waiting threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    pthread_cond_t m_condition; ///< pthread handle of the condition variable
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLEIMPL_HPP
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/SemaphoreImpl.hpp>
+#include <SFML/System/Unix/ClockImpl.hpp>
+#include <errno.h>
+#include <time.h>
+
+#if defined(SFML_SYSTEM_LINUX)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Convert a duration in microseconds to a timespec
+    timespec toTimespec(sf::Int64 usecs)
+    {
+        timespec time;
+        time.tv_sec  = static_cast<time_t>(usecs / 1000000);
+        time.tv_nsec = static_cast<long>(usecs % 1000000) * 1000;
+        return time;
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Sleep while the futex word equals value, or wake up count threads sleeping on it
+    int futex(volatile int* address, int operation, int value, const timespec* timeout)
+    {
+        return static_cast<int>(syscall(SYS_futex, address, operation, value, timeout, NULL, 0));
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::SemaphoreImpl(unsigned int count) :
+m_count  (static_cast<int>(count)),
+m_waiters(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::~SemaphoreImpl()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::post()
+{
+    // Both operations are full memory barriers: a thread going to sleep
+    // either sees the new count, or is seen as a waiter here
+    __sync_fetch_and_add(&m_count, 1);
+    if (m_waiters > 0)
+        futex(&m_count, FUTEX_WAKE_PRIVATE, 1, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::wait()
+{
+    while (!tryWait())
+    {
+        // Sleep only if the counter is still zero
+        __sync_fetch_and_add(&m_waiters, 1);
+        futex(&m_count, FUTEX_WAIT_PRIVATE, 0, NULL);
+        __sync_fetch_and_sub(&m_waiters, 1);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::wait(Time timeout)
+{
+    Int64 end = ClockImpl::getCurrentTime().asMicroseconds() + timeout.asMicroseconds();
+    while (!tryWait())
+    {
+        Int64 remaining = end - ClockImpl::getCurrentTime().asMicroseconds();
+        if (remaining <= 0)
+            return false;
+
+        // The futex timeout is relative
+        timespec delay = toTimespec(remaining);
+        __sync_fetch_and_add(&m_waiters, 1);
+        futex(&m_count, FUTEX_WAIT_PRIVATE, 0, &delay);
+        __sync_fetch_and_sub(&m_waiters, 1);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::tryWait()
+{
+    int count = m_count;
+    while (count > 0)
+    {
+        int previous = __sync_val_compare_and_swap(&m_count, count, count - 1);
+        if (previous == count)
+            return true;
+
+        count = previous;
+    }
+
+    return false;
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::SemaphoreImpl(unsigned int count) :
+m_count(count)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+
+#if defined(SFML_SYSTEM_MACOS)
+    pthread_cond_init(&m_condition, NULL);
+#else
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_condition, &attributes);
+    pthread_condattr_destroy(&attributes);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::~SemaphoreImpl()
+{
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::post()
+{
+    pthread_mutex_lock(&m_mutex);
+    m_count++;
+    pthread_mutex_unlock(&m_mutex);
+
+    pthread_cond_signal(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::wait()
+{
+    pthread_mutex_lock(&m_mutex);
+    while (m_count == 0)
+        pthread_cond_wait(&m_condition, &m_mutex);
+    m_count--;
+    pthread_mutex_unlock(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::wait(Time timeout)
+{
+    Int64 end = ClockImpl::getCurrentTime().asMicroseconds() + timeout.asMicroseconds();
+
+    pthread_mutex_lock(&m_mutex);
+    while (m_count == 0)
+    {
+        Int64 remaining = end - ClockImpl::getCurrentTime().asMicroseconds();
+        if (remaining <= 0)
+            break;
+
+    #if defined(SFML_SYSTEM_MACOS)
+        timespec delay = toTimespec(remaining);
+        pthread_cond_timedwait_relative_np(&m_condition, &m_mutex, &delay);
+    #else
+        timespec deadline = toTimespec(end);
+        pthread_cond_timedwait(&m_condition, &m_mutex, &deadline);
+    #endif
+    }
+
+    bool decremented = (m_count > 0);
+    if (decremented)
+        m_count--;
+    pthread_mutex_unlock(&m_mutex);
+
+    return decremented;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::tryWait()
+{
+    pthread_mutex_lock(&m_mutex);
+    bool decremented = (m_count > 0);
+    if (decremented)
+        m_count--;
+    pthread_mutex_unlock(&m_mutex);
+
+    return decremented;
+}
+
+#endif
+
+} // namespace priv
+
+} // namespace sf
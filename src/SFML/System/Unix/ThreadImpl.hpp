@@ -65,6 +65,14 @@ public :
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that the hardware can run concurrently
+    ///
+    /// \return Number of hardware threads, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getHardwareConcurrency();
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -66,6 +66,25 @@ Time ClockImpl::getCurrentTime()
     return sf::microseconds(1000000 * time.QuadPart / frequency.QuadPart);
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 ClockImpl::getCurrentNanoseconds()
+{
+    // Unlike getCurrentTime, this function is meant to be called
+    // at a high rate, so it doesn't pay for the two affinity changes
+    // (the performance counter is synchronized across cores on
+    // all the systems that support an invariant TSC)
+    static LARGE_INTEGER frequency = getFrequency();
+
+    LARGE_INTEGER time;
+    QueryPerformanceCounter(&time);
+
+    // Split the conversion to avoid overflowing 64 bits
+    Uint64 seconds = time.QuadPart / frequency.QuadPart;
+    Uint64 remainder = time.QuadPart % frequency.QuadPart;
+    return seconds * 1000000000 + remainder * 1000000000 / frequency.QuadPart;
+}
+
 } // namespace priv
 
 } // namespace sf
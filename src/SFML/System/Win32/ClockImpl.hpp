@@ -51,6 +51,14 @@ public :
     ///
     ////////////////////////////////////////////////////////////
     static Time getCurrentTime();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time with nanosecond resolution
+    ///
+    /// \return Current time, in nanoseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getCurrentNanoseconds();
 };
 
 } // namespace priv
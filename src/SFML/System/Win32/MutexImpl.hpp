@@ -69,6 +69,8 @@ public :
 
 private :
 
+    friend class ConditionVariableImpl;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2013 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SEMAPHOREIMPL_HPP
+#define SFML_SEMAPHOREIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <windows.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Windows implementation of semaphores
+////////////////////////////////////////////////////////////
+class SemaphoreImpl : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial value of the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    SemaphoreImpl(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SemaphoreImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive and decrement it
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive or a timeout expires
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the counter was decremented
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the counter if it is positive
+    ///
+    /// \return True if the counter was decremented
+    ///
+    ////////////////////////////////////////////////////////////
+    bool tryWait();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    HANDLE m_semaphore; ///< Win32 handle of the semaphore
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHOREIMPL_HPP
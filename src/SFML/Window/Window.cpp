@@ -28,8 +28,8 @@
 #include <SFML/Window/Window.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 
 
 namespace
@@ -44,7 +44,6 @@ namespace sf
 Window::Window() :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
 m_size          (0, 0)
 {
 
@@ -55,7 +54,6 @@ m_size          (0, 0)
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
 m_size          (0, 0)
 {
     create(mode, title, style, settings);
@@ -66,7 +64,6 @@ m_size          (0, 0)
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
 m_size          (0, 0)
 {
     create(handle, settings);
@@ -299,9 +296,16 @@ void Window::setKeyRepeatEnabled(bool enabled)
 void Window::setFramerateLimit(unsigned int limit)
 {
     if (limit > 0)
-        m_frameTimeLimit = seconds(1.f / limit);
+        m_framePacer.setFrameTime(microseconds(1000000 / limit));
     else
-        m_frameTimeLimit = Time::Zero;
+        m_framePacer.setFrameTime(Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer::Statistics Window::getFrameStatistics() const
+{
+    return m_framePacer.getStatistics();
 }
 
 
@@ -338,16 +342,17 @@ bool Window::setActive(bool active) const
 ////////////////////////////////////////////////////////////
 void Window::display()
 {
+    SFML_PROFILE_ZONE("Window::display");
+
+    // Let derived classes finish the frame
+    onDisplay();
+
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
 
     // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+    m_framePacer.wait();
 }
 
 
@@ -372,6 +377,13 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {
@@ -403,7 +415,7 @@ void Window::initialize()
     m_size = m_impl->getSize();
 
     // Reset frame time
-    m_clock.restart();
+    m_framePacer.reset();
 
     // Activate the window
     setActive();